@@ -0,0 +1,520 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            main.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Benchmark entrypoint
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <libseastar/extqueue.h>
+#include <libseastar/parallel.h>
+#include <libseastar/reactor.h>
+#include <libseastar/snapshot.h>
+#include <libseastar/sorted.h>
+#include <libseastar/vector.h>
+#include <libseastar/wsdeque.h>
+
+static const size_t BENCH_VECTOR_SIZE = 1 << 20;
+static const size_t BENCH_ROUNDS = 50;
+
+static double now_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+static void report(const char *name, double start, size_t operations) {
+    printf("%-32s %8.3f ns/op\n", name, (now_ns() - start) / operations);
+}
+
+// Fill a vector with BENCH_VECTOR_SIZE pointers into data
+static void fill_vector(Vector *vector, uintptr_t *data) {
+    cs_vector_init(vector);
+    for (size_t i = 0; i < BENCH_VECTOR_SIZE; ++i) {
+        data[i] = i;
+        cs_vector_push_back(vector, &data[i]);
+    }
+}
+
+void bench_vector_get_set() {
+    uintptr_t *data = malloc(BENCH_VECTOR_SIZE * sizeof(uintptr_t));
+    Vector vector;
+    fill_vector(&vector, data);
+
+    uintptr_t sum = 0;
+    double start = now_ns();
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+        for (size_t i = 0; i < BENCH_VECTOR_SIZE; ++i) {
+            PointerResult result = cs_vector_get(&vector, i);
+            sum += *(uintptr_t *)result.value;
+        }
+    }
+    report("cs_vector_get", start, BENCH_ROUNDS * BENCH_VECTOR_SIZE);
+
+    start = now_ns();
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+        for (size_t i = 0; i < BENCH_VECTOR_SIZE; ++i) {
+            cs_vector_set(&vector, i, &data[BENCH_VECTOR_SIZE - 1 - i]);
+        }
+    }
+    report("cs_vector_set", start, BENCH_ROUNDS * BENCH_VECTOR_SIZE);
+
+    // Keep the loads from being optimized out
+    fprintf(stderr, "%lu\n", (unsigned long)sum);
+    cs_vector_free(&vector);
+    free(data);
+}
+
+void bench_vector_iter() {
+    uintptr_t *data = malloc(BENCH_VECTOR_SIZE * sizeof(uintptr_t));
+    Vector vector;
+    fill_vector(&vector, data);
+
+    uintptr_t sum = 0;
+    double start = now_ns();
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+        Iterator iter = cs_vector_iter(&vector);
+        uintptr_t *value = NULL;
+        while (NULL != (value = cs_iter_next(&iter))) {
+            sum += *value;
+        }
+    }
+    report("cs_iter_next (Vector)", start, BENCH_ROUNDS * BENCH_VECTOR_SIZE);
+
+    fprintf(stderr, "%lu\n", (unsigned long)sum);
+    cs_vector_free(&vector);
+    free(data);
+}
+
+static int compare_uintptr(const void *one, const void *two) {
+    uintptr_t first = **(uintptr_t **)one;
+    uintptr_t second = **(uintptr_t **)two;
+    return (first > second) - (first < second);
+}
+
+void bench_sorted_search() {
+    const size_t size = 1 << 22;
+    const size_t lookups = 1 << 22;
+    uintptr_t *data = malloc(size * sizeof(uintptr_t));
+    Vector elements;
+    cs_vector_init(&elements);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = 2 * i;
+        cs_vector_push_back(&elements, &data[i]);
+    }
+
+    SortedVector sorted;
+    cs_sorted_init(&sorted, compare_uintptr);
+    cs_sorted_build(&sorted, &elements);
+
+    uintptr_t sum = 0;
+    for (int frozen = 0; frozen < 2; ++frozen) {
+        srand(1);
+        double start = now_ns();
+        for (size_t i = 0; i < lookups; ++i) {
+            uintptr_t key = (uintptr_t)rand() % (2 * size);
+            sum += cs_sorted_lower_bound(&sorted, &key).value;
+        }
+        report(frozen ? "cs_sorted_lower_bound (Eyt)"
+                      : "cs_sorted_lower_bound",
+            start, lookups);
+        cs_sorted_freeze(&sorted);
+    }
+
+    fprintf(stderr, "%lu\n", (unsigned long)sum);
+    cs_sorted_free(&sorted);
+    cs_vector_free(&elements);
+    free(data);
+}
+
+// A heap object the size of a cache line
+typedef struct BenchObject {
+    uintptr_t fields[8];
+} BenchObject;
+
+// Fold every field of the object into a running hash. Each element does
+// enough dependent work to fill the out-of-order window, which is what keeps
+// the hardware from overlapping the cache misses on its own.
+static uintptr_t hash_object(uintptr_t hash, BenchObject *object) {
+    for (size_t i = 0; i < 8; ++i) {
+        hash ^= object->fields[i];
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+static void hash_visitor(void *user_data, void *context) {
+    *(uintptr_t *)context = hash_object(*(uintptr_t *)context, user_data);
+}
+
+void bench_vector_prefetch() {
+    // Allocate the objects individually, then shuffle the pointers, so that
+    // consecutive elements are scattered across a working set much larger
+    // than the last-level cache.
+    const size_t size = 1 << 22;
+    Vector vector;
+    cs_vector_init(&vector);
+    for (size_t i = 0; i < size; ++i) {
+        BenchObject *object = malloc(sizeof(BenchObject));
+        for (size_t j = 0; j < 8; ++j) {
+            object->fields[j] = i + j;
+        }
+        cs_vector_push_back(&vector, object);
+    }
+    srand(1);
+    for (size_t i = size - 1; i > 0; --i) {
+        size_t j = (((size_t)rand() << 16) ^ (size_t)rand()) % (i + 1);
+        void *swap = vector.container[i];
+        vector.container[i] = vector.container[j];
+        vector.container[j] = swap;
+    }
+
+    uintptr_t sum = 0;
+    const size_t distances[] = {0, CS_VECTOR_DEFAULT_PREFETCH};
+    for (size_t d = 0; d < 2; ++d) {
+        vector.prefetch = distances[d];
+        double start = now_ns();
+        cs_vector_for_each(&vector, hash_visitor, &sum);
+        report(d ? "cs_vector_for_each (prefetch)" : "cs_vector_for_each",
+            start, size);
+
+        start = now_ns();
+        Iterator iter = cs_vector_iter(&vector);
+        BenchObject *object = NULL;
+        while (NULL != (object = cs_iter_next(&iter))) {
+            sum = hash_object(sum, object);
+        }
+        report(d ? "cs_iter_next (prefetch)" : "cs_iter_next (scattered)",
+            start, size);
+    }
+
+    fprintf(stderr, "%lu\n", (unsigned long)sum);
+    for (size_t i = 0; i < size; ++i) {
+        free(vector.container[i]);
+    }
+    cs_vector_free(&vector);
+}
+
+#define BENCH_MAX_WORKERS 8
+
+typedef struct BenchScheduler {
+    size_t workers;
+    WorkDeque deques[BENCH_MAX_WORKERS];
+    atomic_size_t remaining;
+    atomic_uintptr_t sum;
+} BenchScheduler;
+
+typedef struct BenchWorker {
+    BenchScheduler *scheduler;
+    size_t id;
+} BenchWorker;
+
+// A task of roughly half a microsecond of work
+static uintptr_t run_task(uintptr_t task) {
+    for (size_t i = 0; i < 256; ++i) {
+        task ^= task >> 29;
+        task *= 0x9E3779B97F4A7C15ull;
+    }
+    return task;
+}
+
+static void *bench_worker(void *argument) {
+    BenchWorker *worker = argument;
+    BenchScheduler *scheduler = worker->scheduler;
+    WorkDeque *own = &scheduler->deques[worker->id];
+    uintptr_t sum = 0;
+    size_t victim = worker->id;
+    while (atomic_load_explicit(&scheduler->remaining, memory_order_relaxed)
+        > 0) {
+        PointerResult result = cs_wsdeque_pop(own);
+        if (!result.ok) {
+            victim = (victim + 1) % scheduler->workers;
+            result = cs_wsdeque_steal(&scheduler->deques[victim]);
+        }
+        if (result.ok) {
+            sum += run_task((uintptr_t)result.value);
+            atomic_fetch_sub_explicit(
+                &scheduler->remaining, 1, memory_order_relaxed);
+        }
+    }
+    atomic_fetch_add(&scheduler->sum, sum);
+    return NULL;
+}
+
+void bench_wsdeque_scaling() {
+    const size_t tasks = 1 << 18;
+    for (size_t workers = 1; workers <= BENCH_MAX_WORKERS; workers *= 2) {
+        BenchScheduler scheduler;
+        scheduler.workers = workers;
+        for (size_t i = 0; i < workers; ++i) {
+            cs_wsdeque_init(&scheduler.deques[i], 0);
+        }
+        atomic_init(&scheduler.remaining, tasks);
+        atomic_init(&scheduler.sum, 0);
+
+        // All of the work starts on worker 0, so the rest must steal it
+        for (uintptr_t task = 1; task <= tasks; ++task) {
+            cs_wsdeque_push(&scheduler.deques[0], (void *)task);
+        }
+
+        pthread_t threads[BENCH_MAX_WORKERS];
+        BenchWorker arguments[BENCH_MAX_WORKERS];
+        double start = now_ns();
+        for (size_t i = 0; i < workers; ++i) {
+            arguments[i] = (BenchWorker){.scheduler = &scheduler, .id = i};
+            pthread_create(&threads[i], NULL, bench_worker, &arguments[i]);
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "cs_wsdeque (%zu workers)", workers);
+        report(name, start, tasks);
+        fprintf(stderr, "%lu\n", (unsigned long)atomic_load(&scheduler.sum));
+        for (size_t i = 0; i < workers; ++i) {
+            cs_wsdeque_free(&scheduler.deques[i]);
+        }
+    }
+}
+
+static void *reduce_task(void *accumulator, void *user_data, void *context) {
+    (void)context;
+    uintptr_t value = run_task(*(uintptr_t *)user_data);
+    return (void *)((uintptr_t)accumulator + value);
+}
+
+static void *combine_sum(void *left, void *right, void *context) {
+    (void)context;
+    return (void *)((uintptr_t)left + (uintptr_t)right);
+}
+
+void bench_parallel_reduce() {
+    const size_t size = 1 << 18;
+    uintptr_t *data = malloc(size * sizeof(uintptr_t));
+    Vector vector;
+    cs_vector_init(&vector);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = i;
+        cs_vector_push_back(&vector, &data[i]);
+    }
+
+    uintptr_t serial = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < size; ++i) {
+        serial += run_task(data[i]);
+    }
+    report("serial reduce", start, size);
+
+    for (size_t threads = 1; threads <= BENCH_MAX_WORKERS; threads *= 2) {
+        ThreadPool pool;
+        cs_threadpool_init(&pool, threads);
+        start = now_ns();
+        PointerResult result = cs_vector_parallel_reduce(
+            &pool, &vector, reduce_task, combine_sum, NULL, NULL);
+
+        char name[64];
+        snprintf(name, sizeof(name), "cs_vector_parallel_reduce (%zu)",
+            threads);
+        report(name, start, size);
+        if ((uintptr_t)result.value != serial) {
+            fprintf(stderr, "parallel reduce disagrees with serial\n");
+        }
+        cs_threadpool_free(&pool);
+    }
+
+    fprintf(stderr, "%lu\n", (unsigned long)serial);
+    cs_vector_free(&vector);
+    free(data);
+}
+
+// Compare a read-side critical section of the snapshot vector against taking
+// a reader-writer lock around the same vector.
+void bench_snapshot_read() {
+    const size_t reads = 1 << 24;
+    SnapshotVector snapshot;
+    cs_snapshot_init(&snapshot);
+    PointerResult draft = cs_snapshot_write_begin(&snapshot);
+    for (uintptr_t i = 0; i < 64; ++i) {
+        cs_vector_push_back(draft.value, (void *)i);
+    }
+    cs_snapshot_publish(&snapshot);
+    SnapshotReader reader;
+    cs_snapshot_register(&snapshot, &reader);
+
+    uintptr_t sum = 0;
+    double start = now_ns();
+    for (size_t i = 0; i < reads; ++i) {
+        Vector *view = cs_snapshot_read_begin(&snapshot, &reader);
+        sum += (uintptr_t)view->container[i % view->size];
+        cs_snapshot_read_end(&reader);
+    }
+    report("cs_snapshot_read_begin/end", start, reads);
+
+    pthread_rwlock_t lock;
+    pthread_rwlock_init(&lock, NULL);
+    Vector *vector = cs_snapshot_read_begin(&snapshot, &reader);
+    start = now_ns();
+    for (size_t i = 0; i < reads; ++i) {
+        pthread_rwlock_rdlock(&lock);
+        sum += (uintptr_t)vector->container[i % vector->size];
+        pthread_rwlock_unlock(&lock);
+    }
+    report("pthread_rwlock_rdlock/unlock", start, reads);
+    cs_snapshot_read_end(&reader);
+
+    fprintf(stderr, "%lu\n", (unsigned long)sum);
+    pthread_rwlock_destroy(&lock);
+    cs_snapshot_unregister(&snapshot, &reader);
+    cs_snapshot_free(&snapshot);
+}
+
+static int compare_record(const void *one, const void *two) {
+    uintptr_t left = *(const uintptr_t *)one;
+    uintptr_t right = *(const uintptr_t *)two;
+    return (left > right) - (left < right);
+}
+
+// Push 16 times more records than the in-memory budget holds, then pop them
+// all back through the merge of the spilled runs.
+void bench_extqueue() {
+    const size_t records = 1 << 22;
+    const size_t budget = records / 16 * 2 * sizeof(uintptr_t);
+    ExternalQueue queue;
+    cs_extqueue_init(&queue, 2 * sizeof(uintptr_t), budget, compare_record);
+
+    uintptr_t record[2] = {0};
+    srand(4);
+    double start = now_ns();
+    for (size_t i = 0; i < records; ++i) {
+        record[0] = ((uintptr_t)rand() << 16) ^ (uintptr_t)rand();
+        record[1] = i;
+        cs_extqueue_push(&queue, record);
+    }
+    report("cs_extqueue_push", start, records);
+
+    uintptr_t sum = 0;
+    start = now_ns();
+    for (size_t i = 0; i < records; ++i) {
+        cs_extqueue_pop(&queue, record);
+        sum += record[1];
+    }
+    report("cs_extqueue_pop", start, records);
+
+    fprintf(stderr, "%lu\n", (unsigned long)sum);
+    cs_extqueue_free(&queue);
+}
+
+typedef struct BenchPingPong {
+    Reactor reactor;
+    size_t remaining;
+} BenchPingPong;
+
+// Bounce a byte back to the other end of the socketpair until done
+static void bench_bounce(int fd, uint32_t events, void *context) {
+    (void)events;
+    BenchPingPong *pingpong = context;
+    char byte;
+    if (1 != read(fd, &byte, 1)) {
+        return;
+    }
+    if (0 == --pingpong->remaining) {
+        cs_reactor_stop(&pingpong->reactor);
+        return;
+    }
+    ssize_t written = write(fd, &byte, 1);
+    (void)written;
+}
+
+static void bench_timer_noop(void *context) {
+    (void)context;
+}
+
+void bench_reactor() {
+    const size_t count = 1 << 20;
+    BenchPingPong pingpong;
+    cs_reactor_init(&pingpong.reactor, 0);
+
+    ReactorTimer *timers = malloc(count * sizeof(ReactorTimer));
+    srand(5);
+    double start = now_ns();
+    for (size_t i = 0; i < count; ++i) {
+        cs_reactor_timer_init(&timers[i], bench_timer_noop, NULL);
+        cs_reactor_timer_start(
+            &pingpong.reactor, &timers[i], 1000 + rand() % 100000);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        cs_reactor_timer_cancel(&pingpong.reactor, &timers[i]);
+    }
+    report("cs_reactor_timer_start/cancel", start, count);
+    free(timers);
+
+    const size_t bounces = 1 << 16;
+    int sockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+    ReactorWatch watches[2];
+    for (int i = 0; i < 2; ++i) {
+        cs_reactor_add(&pingpong.reactor, &watches[i], sockets[i], EPOLLIN,
+            bench_bounce, &pingpong);
+    }
+    pingpong.remaining = bounces;
+    ssize_t written = write(sockets[0], "x", 1);
+    (void)written;
+    start = now_ns();
+    cs_reactor_run(&pingpong.reactor);
+    report("cs_reactor socketpair bounce", start, bounces);
+
+    close(sockets[0]);
+    close(sockets[1]);
+    cs_reactor_free(&pingpong.reactor);
+}
+
+int main() {
+    bench_vector_get_set();
+    bench_vector_iter();
+    bench_sorted_search();
+    bench_vector_prefetch();
+    bench_wsdeque_scaling();
+    bench_parallel_reduce();
+    bench_snapshot_read();
+    bench_extqueue();
+    bench_reactor();
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,500 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            bitset.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the bit vector
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libseastar/bitset.h>
+#include <libseastar/error.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+static const size_t CS_BITSET_WORD_BITS = 64;
+
+// Number of words required to hold size bits
+static size_t priv_bitset_words(size_t size) {
+    return (size + CS_BITSET_WORD_BITS - 1) / CS_BITSET_WORD_BITS;
+}
+
+// Clear the bits past the end of the bitset in the last word. Every operation
+// relies on these bits being clear.
+static void priv_bitset_trim(BitSet *bitset) {
+    size_t remainder = bitset->size % CS_BITSET_WORD_BITS;
+    if (0 != remainder) {
+        bitset->container[bitset->words - 1] &=
+            ((uint64_t)1 << remainder) - 1;
+    }
+}
+
+// Portable popcount. GCC and Clang recognize this sequence, and emit a single
+// popcnt instruction when the target has one. __builtin_popcountll does not
+// help here: without -mpopcnt it becomes a call into libgcc for every word.
+// It is always inlined, so that the popcnt clones below get the instruction
+// at -Os too, rather than a call to the copy compiled for the default target.
+__attribute__((always_inline))
+static inline size_t priv_bitset_popcount(uint64_t word) {
+    word -= (word >> 1) & 0x5555555555555555ull;
+    word = (word & 0x3333333333333333ull)
+        + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (word * 0x0101010101010101ull) >> 56;
+}
+
+// GCC announces ThreadSanitizer with a macro, Clang through __has_feature
+#if defined(__SANITIZE_THREAD__)
+#define CS_BITSET_THREAD_SANITIZER
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define CS_BITSET_THREAD_SANITIZER
+#endif
+#endif
+
+// On x86, the loops over whole words are also compiled for CPUs with popcnt,
+// and the dynamic loader picks the version to use. ThreadSanitizer builds go
+// without: the loader runs the resolver before the TSan runtime is set up.
+#if defined(__x86_64__) && !defined(__POPCNT__) && defined(__has_attribute) \
+    && !defined(CS_BITSET_THREAD_SANITIZER)
+#if __has_attribute(target_clones)
+#define CS_BITSET_POPCOUNT_CLONES                                             \
+    __attribute__((target_clones("popcnt", "default")))
+#endif
+#endif
+#ifndef CS_BITSET_POPCOUNT_CLONES
+#define CS_BITSET_POPCOUNT_CLONES
+#endif
+
+// Count the set bits in count words
+CS_BITSET_POPCOUNT_CLONES
+static size_t priv_bitset_count_words(const uint64_t *words, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += priv_bitset_popcount(words[i]);
+    }
+    return total;
+}
+
+// Find the word holding the nth set bit, leaving in n the number of set bits
+// to skip within that word. Returns count if there are too few set bits.
+CS_BITSET_POPCOUNT_CLONES
+static size_t priv_bitset_select_word(const uint64_t *words, size_t count,
+    size_t *n) {
+    for (size_t i = 0; i < count; ++i) {
+        size_t bits = priv_bitset_popcount(words[i]);
+        if (*n < bits) {
+            return i;
+        }
+        *n -= bits;
+    }
+    return count;
+}
+
+// Check that two bitsets can be combined
+static VoidResult priv_bitset_check(BitSet *one, BitSet *two) {
+    if (one->size != two->size) {
+        return (VoidResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_ARGUMENT};
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        private_iter_next
+//
+// DESCRIPTION:     Return the next set bit in the iterator.
+//
+// ARGUMENTS:       private: The BitSet*
+//                  state: The index to resume searching from
+//
+// RETURN:          The index of the next set bit plus one, or NULL.
+////
+static void *private_iter_next(void *private, union IteratorState *state) {
+    BitSet *bitset = (BitSet *)private;
+    IndexResult result = cs_bitset_next(bitset, state->size);
+    if (!result.ok) {
+        state->size = bitset->size;
+        return NULL;
+    }
+
+    state->size = result.value + 1;
+    return (void *)(uintptr_t)(result.value + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_init
+//
+// DESCRIPTION:     Initialize the bitset with all bits clear
+//
+// ARGUMENTS:       size: The number of bits in the bitset
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_init(BitSet *bitset, size_t size) {
+    bitset->size = size;
+    bitset->words = priv_bitset_words(size);
+    bitset->container = calloc(bitset->words ? bitset->words : 1,
+        sizeof(uint64_t));
+    if (NULL == bitset->container) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_resize
+//
+// DESCRIPTION:     Change the number of bits in the bitset. Bits that are
+//                  added are clear, and bits past the new size are dropped.
+//
+// ARGUMENTS:       size: The new number of bits
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_resize(BitSet *bitset, size_t size) {
+    size_t words = priv_bitset_words(size);
+    if (words != bitset->words) {
+        uint64_t *new_container =
+            realloc(bitset->container, (words ? words : 1) * sizeof(uint64_t));
+        if (NULL == new_container) {
+            return (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | errno};
+        }
+        bitset->container = new_container;
+        if (words > bitset->words) {
+            memset(bitset->container + bitset->words, 0,
+                (words - bitset->words) * sizeof(uint64_t));
+        }
+    }
+
+    bitset->size = size;
+    bitset->words = words;
+    priv_bitset_trim(bitset);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_test
+//
+// DESCRIPTION:     Test the bit at index.
+//
+// ARGUMENTS:       index: The bit to test
+//
+// RETURN:          BoolResult, with value set to the bit if ok.
+////
+BoolResult cs_bitset_test(BitSet *bitset, size_t index) {
+    if (index >= bitset->size) {
+        return (BoolResult){.ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    uint64_t word = bitset->container[index / CS_BITSET_WORD_BITS];
+    return (BoolResult){
+        .ok = true, .value = (word >> (index % CS_BITSET_WORD_BITS)) & 1};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_set
+//
+// DESCRIPTION:     Set the bit at index.
+//
+// ARGUMENTS:       index: The bit to set
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_set(BitSet *bitset, size_t index) {
+    if (index >= bitset->size) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    bitset->container[index / CS_BITSET_WORD_BITS] |=
+        (uint64_t)1 << (index % CS_BITSET_WORD_BITS);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_clear
+//
+// DESCRIPTION:     Clear the bit at index.
+//
+// ARGUMENTS:       index: The bit to clear
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_clear(BitSet *bitset, size_t index) {
+    if (index >= bitset->size) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    bitset->container[index / CS_BITSET_WORD_BITS] &=
+        ~((uint64_t)1 << (index % CS_BITSET_WORD_BITS));
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_count
+//
+// DESCRIPTION:     Count the set bits in the bitset.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          The number of set bits
+////
+size_t cs_bitset_count(BitSet *bitset) {
+    return priv_bitset_count_words(bitset->container, bitset->words);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_rank
+//
+// DESCRIPTION:     Count the set bits strictly before index.
+//
+// ARGUMENTS:       index: The end of the range to count, at most size
+//
+// RETURN:          IndexResult containing the number of set bits.
+////
+IndexResult cs_bitset_rank(BitSet *bitset, size_t index) {
+    if (index > bitset->size) {
+        return (IndexResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    size_t words = index / CS_BITSET_WORD_BITS;
+    size_t count = priv_bitset_count_words(bitset->container, words);
+
+    size_t remainder = index % CS_BITSET_WORD_BITS;
+    if (0 != remainder) {
+        count += priv_bitset_popcount(
+            bitset->container[words] & (((uint64_t)1 << remainder) - 1));
+    }
+    return (IndexResult){.ok = true, .value = count};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_select
+//
+// DESCRIPTION:     Find the nth set bit, i.e. the inverse of cs_bitset_rank.
+//
+// ARGUMENTS:       n: The number of set bits to skip
+//
+// RETURN:          IndexResult containing the index of the bit, or
+//                  SEASTAR_ERROR_INVALID_INDEX if fewer than n + 1 bits are
+//                  set.
+////
+IndexResult cs_bitset_select(BitSet *bitset, size_t n) {
+    size_t i = priv_bitset_select_word(bitset->container, bitset->words, &n);
+    if (i == bitset->words) {
+        return (IndexResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    uint64_t word = bitset->container[i];
+    for (; n > 0; --n) {
+        word &= word - 1;
+    }
+    return (IndexResult){
+        .ok = true, .value = i * CS_BITSET_WORD_BITS + __builtin_ctzll(word)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_next
+//
+// DESCRIPTION:     Find the first set bit at or after index.
+//
+// ARGUMENTS:       index: The bit to start searching from
+//
+// RETURN:          IndexResult containing the index of the bit, or
+//                  SEASTAR_ERROR_INVALID_INDEX if there are none.
+////
+IndexResult cs_bitset_next(BitSet *bitset, size_t index) {
+    if (index >= bitset->size) {
+        return (IndexResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    size_t i = index / CS_BITSET_WORD_BITS;
+    uint64_t word =
+        bitset->container[i] & (~(uint64_t)0 << (index % CS_BITSET_WORD_BITS));
+    while (0 == word) {
+        if (++i >= bitset->words) {
+            return (IndexResult){
+                .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+        }
+        word = bitset->container[i];
+    }
+
+    return (IndexResult){
+        .ok = true, .value = i * CS_BITSET_WORD_BITS + __builtin_ctzll(word)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_and
+//
+// DESCRIPTION:     destination = destination & source
+//
+// ARGUMENTS:       destination: The bitset to modify
+//                  source: A bitset of the same size
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_and(BitSet *destination, BitSet *source) {
+    VoidResult result = priv_bitset_check(destination, source);
+    if (!result.ok) {
+        return result;
+    }
+
+    // Hoisted so that the compiler knows the stores can't modify them, and
+    // can vectorize the loop
+    uint64_t *to = destination->container;
+    const uint64_t *from = source->container;
+    size_t words = destination->words;
+    for (size_t i = 0; i < words; ++i) {
+        to[i] &= from[i];
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_or
+//
+// DESCRIPTION:     destination = destination | source
+//
+// ARGUMENTS:       destination: The bitset to modify
+//                  source: A bitset of the same size
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_or(BitSet *destination, BitSet *source) {
+    VoidResult result = priv_bitset_check(destination, source);
+    if (!result.ok) {
+        return result;
+    }
+
+    uint64_t *to = destination->container;
+    const uint64_t *from = source->container;
+    size_t words = destination->words;
+    for (size_t i = 0; i < words; ++i) {
+        to[i] |= from[i];
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_xor
+//
+// DESCRIPTION:     destination = destination ^ source
+//
+// ARGUMENTS:       destination: The bitset to modify
+//                  source: A bitset of the same size
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_xor(BitSet *destination, BitSet *source) {
+    VoidResult result = priv_bitset_check(destination, source);
+    if (!result.ok) {
+        return result;
+    }
+
+    uint64_t *to = destination->container;
+    const uint64_t *from = source->container;
+    size_t words = destination->words;
+    for (size_t i = 0; i < words; ++i) {
+        to[i] ^= from[i];
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_andnot
+//
+// DESCRIPTION:     destination = destination & ~source
+//
+// ARGUMENTS:       destination: The bitset to modify
+//                  source: A bitset of the same size
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_bitset_andnot(BitSet *destination, BitSet *source) {
+    VoidResult result = priv_bitset_check(destination, source);
+    if (!result.ok) {
+        return result;
+    }
+
+    uint64_t *to = destination->container;
+    const uint64_t *from = source->container;
+    size_t words = destination->words;
+    for (size_t i = 0; i < words; ++i) {
+        to[i] &= ~from[i];
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_free
+//
+// DESCRIPTION:     De-initialize the bitset, freeing internal memory.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_bitset_free(BitSet *bitset) {
+    if (NULL != bitset->container) {
+        free(bitset->container);
+        bitset->container = NULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_bitset_iter
+//
+// DESCRIPTION:     Return an iterator over the indices of the set bits, in
+//                  ascending order. Use CS_BITSET_INDEX to decode the values
+//                  it yields.
+//
+// ARGUMENTS:       bitset: The bitset to iterate over.
+//
+// RETURN:          An Iterator
+////
+Iterator cs_bitset_iter(BitSet *bitset) {
+    Iterator iter = {0};
+    iter.next = private_iter_next;
+    iter.private = bitset;
+    return iter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
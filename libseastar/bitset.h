@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            bitset.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Dynamically-sized bit vector
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_BITSET_H
+#define SEASTAR_BITSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libseastar/iterator.h>
+#include <libseastar/result.h>
+
+// The iterator for a BitSet yields the index of each set bit, offset by one so
+// that index 0 is not mistaken for the end of iteration. This macro recovers
+// the index from a value returned by cs_iter_next.
+#define CS_BITSET_INDEX(value) ((size_t)(uintptr_t)(value) - 1)
+
+// BitSet: Packs one bit per element into 64-bit words. Bulk operations work a
+// whole word at a time, in loops simple enough for the compiler to vectorize.
+typedef struct BitSet {
+    // NOT USER CUSTOMIZABLE
+    size_t size;
+    size_t words;
+    uint64_t *container;
+} BitSet;
+
+// Initialize a bitset of size bits, all clear
+VoidResult cs_bitset_init(BitSet *bitset, size_t size);
+
+// Grow or shrink the bitset. New bits are clear.
+VoidResult cs_bitset_resize(BitSet *bitset, size_t size);
+
+// Get/set values
+BoolResult cs_bitset_test(BitSet *bitset, size_t index);
+VoidResult cs_bitset_set(BitSet *bitset, size_t index);
+VoidResult cs_bitset_clear(BitSet *bitset, size_t index);
+
+// Number of set bits in the bitset
+size_t cs_bitset_count(BitSet *bitset);
+
+// Number of set bits before index
+IndexResult cs_bitset_rank(BitSet *bitset, size_t index);
+
+// Index of the nth set bit, counting from 0
+IndexResult cs_bitset_select(BitSet *bitset, size_t n);
+
+// Index of the first set bit at or after index
+IndexResult cs_bitset_next(BitSet *bitset, size_t index);
+
+// Bulk operations, storing the result in destination. Both bitsets must be the
+// same size.
+VoidResult cs_bitset_and(BitSet *destination, BitSet *source);
+VoidResult cs_bitset_or(BitSet *destination, BitSet *source);
+VoidResult cs_bitset_xor(BitSet *destination, BitSet *source);
+VoidResult cs_bitset_andnot(BitSet *destination, BitSet *source);
+
+// De-initialize the bitset
+void cs_bitset_free(BitSet *bitset);
+
+// Iterator over the indices of set bits. See CS_BITSET_INDEX.
+Iterator cs_bitset_iter(BitSet *bitset);
+
+#endif // SEASTAR_BITSET_H
+
+///////////////////////////////////////////////////////////////////////////////
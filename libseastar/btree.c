@@ -0,0 +1,721 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            btree.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the B+-tree
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libseastar/btree.h>
+#include <libseastar/error.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// Nodes are kept at least half full, except for the root
+static const size_t CS_BTREE_MIN_KEYS = CS_BTREE_NODE_KEYS / 2;
+static const size_t CS_BTREE_CACHE_LINE = 64;
+
+typedef struct BTreeLeaf {
+    size_t count;
+    struct BTreeLeaf *next;
+    void *keys[CS_BTREE_NODE_KEYS];
+    void *values[CS_BTREE_NODE_KEYS];
+} BTreeLeaf;
+
+// children[i] holds keys less than keys[i], and children[i + 1] holds keys
+// greater than or equal to it.
+typedef struct BTreeInner {
+    size_t count;
+    void *keys[CS_BTREE_NODE_KEYS];
+    void *children[CS_BTREE_NODE_KEYS + 1];
+} BTreeInner;
+
+// Allocate a cache-line aligned node
+static void *priv_btree_node(size_t size) {
+    size = (size + CS_BTREE_CACHE_LINE - 1) / CS_BTREE_CACHE_LINE
+        * CS_BTREE_CACHE_LINE;
+    void *node = aligned_alloc(CS_BTREE_CACHE_LINE, size);
+    if (NULL != node) {
+        memset(node, 0, size);
+    }
+    return node;
+}
+
+// Number of keys in the node that compare less than key (or less than or
+// equal to key, if upper is set)
+static size_t priv_btree_search(BTree *tree, void **keys, size_t count,
+    void *key, int upper) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (tree->comparator(&keys[middle], &key) < upper) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Descend to the leaf that key belongs in
+static BTreeLeaf *priv_btree_leaf(BTree *tree, void *key) {
+    void *node = tree->root;
+    for (size_t level = tree->height; level > 0; --level) {
+        BTreeInner *inner = node;
+        node = inner->children[priv_btree_search(
+            tree, inner->keys, inner->count, key, 1)];
+    }
+    return node;
+}
+
+// Deepest tree the insert path can handle. Inner nodes are at least half
+// full, so a tree this tall would hold more than 8^32 keys.
+#define CS_BTREE_MAX_HEIGHT 32
+
+// Nodes for an insert to split into, allocated before the tree is modified,
+// so that running out of memory leaves it untouched. nodes[0] is a leaf, and
+// the rest are inner nodes, taken in order from the bottom of the tree up.
+typedef struct BTreeSpares {
+    void *nodes[CS_BTREE_MAX_HEIGHT + 2];
+    size_t next;
+} BTreeSpares;
+
+// The result of inserting into a subtree. If the subtree's root split, right
+// is the new sibling and separator is the smallest key under it.
+typedef struct BTreeSplit {
+    void *right;
+    void *separator;
+} BTreeSplit;
+
+// Insert a key that is not yet in the leaf
+static BTreeSplit priv_btree_insert_leaf(BTree *tree, BTreeLeaf *leaf,
+    void *key, void *value, BTreeSpares *spares) {
+    size_t index = priv_btree_search(tree, leaf->keys, leaf->count, key, 0);
+    if (leaf->count < CS_BTREE_NODE_KEYS) {
+        size_t moved = leaf->count - index;
+        memmove(&leaf->keys[index + 1], &leaf->keys[index],
+            moved * sizeof(void *));
+        memmove(&leaf->values[index + 1], &leaf->values[index],
+            moved * sizeof(void *));
+        leaf->keys[index] = key;
+        leaf->values[index] = value;
+        leaf->count += 1;
+        return (BTreeSplit){0};
+    }
+
+    // Lay out all CS_BTREE_NODE_KEYS + 1 entries, then split them evenly
+    BTreeLeaf *right = spares->nodes[spares->next++];
+    void *keys[CS_BTREE_NODE_KEYS + 1];
+    void *values[CS_BTREE_NODE_KEYS + 1];
+    memcpy(keys, leaf->keys, index * sizeof(void *));
+    memcpy(values, leaf->values, index * sizeof(void *));
+    keys[index] = key;
+    values[index] = value;
+    memcpy(&keys[index + 1], &leaf->keys[index],
+        (leaf->count - index) * sizeof(void *));
+    memcpy(&values[index + 1], &leaf->values[index],
+        (leaf->count - index) * sizeof(void *));
+
+    const size_t total = CS_BTREE_NODE_KEYS + 1;
+    leaf->count = total / 2;
+    right->count = total - leaf->count;
+    memcpy(leaf->keys, keys, leaf->count * sizeof(void *));
+    memcpy(leaf->values, values, leaf->count * sizeof(void *));
+    memcpy(right->keys, &keys[leaf->count], right->count * sizeof(void *));
+    memcpy(right->values, &values[leaf->count], right->count * sizeof(void *));
+    right->next = leaf->next;
+    leaf->next = right;
+    return (BTreeSplit){.right = right, .separator = right->keys[0]};
+}
+
+static BTreeSplit priv_btree_insert_node(BTree *tree, void *node,
+    size_t level, void *key, void *value, BTreeSpares *spares) {
+    if (0 == level) {
+        return priv_btree_insert_leaf(tree, node, key, value, spares);
+    }
+
+    BTreeInner *inner = node;
+    size_t index =
+        priv_btree_search(tree, inner->keys, inner->count, key, 1);
+    BTreeSplit split = priv_btree_insert_node(
+        tree, inner->children[index], level - 1, key, value, spares);
+    if (NULL == split.right) {
+        return split;
+    }
+
+    if (inner->count < CS_BTREE_NODE_KEYS) {
+        size_t moved = inner->count - index;
+        memmove(&inner->keys[index + 1], &inner->keys[index],
+            moved * sizeof(void *));
+        memmove(&inner->children[index + 2], &inner->children[index + 1],
+            moved * sizeof(void *));
+        inner->keys[index] = split.separator;
+        inner->children[index + 1] = split.right;
+        inner->count += 1;
+        return (BTreeSplit){0};
+    }
+
+    BTreeInner *right = spares->nodes[spares->next++];
+    void *keys[CS_BTREE_NODE_KEYS + 1];
+    void *children[CS_BTREE_NODE_KEYS + 2];
+    memcpy(keys, inner->keys, index * sizeof(void *));
+    memcpy(children, inner->children, (index + 1) * sizeof(void *));
+    keys[index] = split.separator;
+    children[index + 1] = split.right;
+    memcpy(&keys[index + 1], &inner->keys[index],
+        (inner->count - index) * sizeof(void *));
+    memcpy(&children[index + 2], &inner->children[index + 1],
+        (inner->count - index) * sizeof(void *));
+
+    // The middle key moves up to the parent
+    const size_t total = CS_BTREE_NODE_KEYS + 1;
+    inner->count = total / 2;
+    right->count = total - inner->count - 1;
+    memcpy(inner->keys, keys, inner->count * sizeof(void *));
+    memcpy(inner->children, children, (inner->count + 1) * sizeof(void *));
+    memcpy(right->keys, &keys[inner->count + 1],
+        right->count * sizeof(void *));
+    memcpy(right->children, &children[inner->count + 1],
+        (right->count + 1) * sizeof(void *));
+    return (BTreeSplit){.right = right, .separator = keys[inner->count]};
+}
+
+// Remove the entry at index from an inner node, along with the child to its
+// right
+static void priv_btree_inner_erase(BTreeInner *inner, size_t index) {
+    size_t moved = inner->count - index - 1;
+    memmove(&inner->keys[index], &inner->keys[index + 1],
+        moved * sizeof(void *));
+    memmove(&inner->children[index + 1], &inner->children[index + 2],
+        moved * sizeof(void *));
+    inner->count -= 1;
+}
+
+// Refill the leaf at parent->children[index], which has underflowed
+static void priv_btree_fix_leaf(BTreeInner *parent, size_t index) {
+    BTreeLeaf *leaf = parent->children[index];
+    BTreeLeaf *left = index > 0 ? parent->children[index - 1] : NULL;
+    BTreeLeaf *right =
+        index < parent->count ? parent->children[index + 1] : NULL;
+
+    if (NULL != left && left->count > CS_BTREE_MIN_KEYS) {
+        memmove(&leaf->keys[1], leaf->keys, leaf->count * sizeof(void *));
+        memmove(&leaf->values[1], leaf->values, leaf->count * sizeof(void *));
+        left->count -= 1;
+        leaf->keys[0] = left->keys[left->count];
+        leaf->values[0] = left->values[left->count];
+        leaf->count += 1;
+        parent->keys[index - 1] = leaf->keys[0];
+    } else if (NULL != right && right->count > CS_BTREE_MIN_KEYS) {
+        leaf->keys[leaf->count] = right->keys[0];
+        leaf->values[leaf->count] = right->values[0];
+        leaf->count += 1;
+        right->count -= 1;
+        memmove(right->keys, &right->keys[1], right->count * sizeof(void *));
+        memmove(right->values, &right->values[1],
+            right->count * sizeof(void *));
+        parent->keys[index] = right->keys[0];
+    } else {
+        // Merge the leaf with a sibling, into the left of the two
+        if (NULL == right) {
+            right = leaf;
+            leaf = left;
+            index -= 1;
+        }
+        memcpy(&leaf->keys[leaf->count], right->keys,
+            right->count * sizeof(void *));
+        memcpy(&leaf->values[leaf->count], right->values,
+            right->count * sizeof(void *));
+        leaf->count += right->count;
+        leaf->next = right->next;
+        free(right);
+        priv_btree_inner_erase(parent, index);
+    }
+}
+
+// Refill the inner node at parent->children[index], which has underflowed
+static void priv_btree_fix_inner(BTreeInner *parent, size_t index) {
+    BTreeInner *node = parent->children[index];
+    BTreeInner *left = index > 0 ? parent->children[index - 1] : NULL;
+    BTreeInner *right =
+        index < parent->count ? parent->children[index + 1] : NULL;
+
+    if (NULL != left && left->count > CS_BTREE_MIN_KEYS) {
+        // Rotate right through the parent
+        memmove(&node->keys[1], node->keys, node->count * sizeof(void *));
+        memmove(&node->children[1], node->children,
+            (node->count + 1) * sizeof(void *));
+        node->keys[0] = parent->keys[index - 1];
+        node->children[0] = left->children[left->count];
+        node->count += 1;
+        parent->keys[index - 1] = left->keys[left->count - 1];
+        left->count -= 1;
+    } else if (NULL != right && right->count > CS_BTREE_MIN_KEYS) {
+        // Rotate left through the parent
+        node->keys[node->count] = parent->keys[index];
+        node->children[node->count + 1] = right->children[0];
+        node->count += 1;
+        parent->keys[index] = right->keys[0];
+        memmove(right->keys, &right->keys[1],
+            (right->count - 1) * sizeof(void *));
+        memmove(right->children, &right->children[1],
+            right->count * sizeof(void *));
+        right->count -= 1;
+    } else {
+        // Merge with a sibling, pulling the separator down between them
+        if (NULL == right) {
+            right = node;
+            node = left;
+            index -= 1;
+        }
+        node->keys[node->count] = parent->keys[index];
+        memcpy(&node->keys[node->count + 1], right->keys,
+            right->count * sizeof(void *));
+        memcpy(&node->children[node->count + 1], right->children,
+            (right->count + 1) * sizeof(void *));
+        node->count += right->count + 1;
+        free(right);
+        priv_btree_inner_erase(parent, index);
+    }
+}
+
+// Remove key from the subtree rooted at node, rebalancing on the way back up.
+// Every separator is the smallest key under the child to its right, so a key
+// that is first in its leaf is also the separator in the deepest ancestor the
+// descent didn't leave through child 0. That slot is passed down in separator
+// and takes the leaf's new first key, so no separator outlives its key.
+static PointerResult priv_btree_remove_node(BTree *tree, void *node,
+    size_t level, void *key, void **separator) {
+    if (0 == level) {
+        BTreeLeaf *leaf = node;
+        size_t index =
+            priv_btree_search(tree, leaf->keys, leaf->count, key, 0);
+        if (index >= leaf->count
+            || 0 != tree->comparator(&leaf->keys[index], &key)) {
+            return (PointerResult){
+                .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+        }
+
+        void *value = leaf->values[index];
+        size_t moved = leaf->count - index - 1;
+        memmove(&leaf->keys[index], &leaf->keys[index + 1],
+            moved * sizeof(void *));
+        memmove(&leaf->values[index], &leaf->values[index + 1],
+            moved * sizeof(void *));
+        leaf->count -= 1;
+        tree->size -= 1;
+        if (0 == index && NULL != separator) {
+            *separator = leaf->keys[0];
+        }
+        return (PointerResult){.ok = true, .value = value};
+    }
+
+    BTreeInner *inner = node;
+    size_t index =
+        priv_btree_search(tree, inner->keys, inner->count, key, 1);
+    if (index > 0) {
+        separator = &inner->keys[index - 1];
+    }
+    PointerResult result = priv_btree_remove_node(
+        tree, inner->children[index], level - 1, key, separator);
+    if (!result.ok) {
+        return result;
+    }
+
+    if (1 == level) {
+        BTreeLeaf *child = inner->children[index];
+        if (child->count < CS_BTREE_MIN_KEYS) {
+            priv_btree_fix_leaf(inner, index);
+        }
+    } else {
+        BTreeInner *child = inner->children[index];
+        if (child->count < CS_BTREE_MIN_KEYS) {
+            priv_btree_fix_inner(inner, index);
+        }
+    }
+    return result;
+}
+
+static void priv_btree_free_node(void *node, size_t level) {
+    if (level > 0) {
+        BTreeInner *inner = node;
+        for (size_t i = 0; i <= inner->count; ++i) {
+            priv_btree_free_node(inner->children[i], level - 1);
+        }
+    }
+    free(node);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        private_range_next
+//
+// DESCRIPTION:     Return the next value in the range.
+//
+// ARGUMENTS:       private: The BTreeRange*
+//                  state: Unused
+//
+// RETURN:          The next value, or NULL.
+////
+static void *private_range_next(void *private, union IteratorState *state) {
+    (void)state;
+    BTreeRange *range = (BTreeRange *)private;
+    while (NULL != range->leaf && range->index >= range->leaf->count) {
+        range->leaf = range->leaf->next;
+        range->index = 0;
+    }
+    if (NULL == range->leaf) {
+        return NULL;
+    }
+
+    void *key = range->leaf->keys[range->index];
+    if (NULL != range->high
+        && range->tree->comparator(&key, &range->high) > 0) {
+        range->leaf = NULL;
+        return NULL;
+    }
+
+    range->key = key;
+    return range->leaf->values[range->index++];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_init
+//
+// DESCRIPTION:     Initialize an empty tree
+//
+// ARGUMENTS:       comparator: The comparison function to order keys by
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_btree_init(BTree *tree, ComparisonFn *comparator) {
+    tree->comparator = comparator;
+    tree->size = 0;
+    tree->height = 0;
+    tree->root = priv_btree_node(sizeof(BTreeLeaf));
+    if (NULL == tree->root) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_insert
+//
+// DESCRIPTION:     Insert a key and value into the tree in O(log n). If the
+//                  key is already present, its value is replaced.
+//
+// ARGUMENTS:       key: The key to insert
+//                  value: The value to associate with it
+//
+// RETURN:          PointerResult containing the replaced value, or NULL if the
+//                  key is new.
+////
+PointerResult cs_btree_insert(BTree *tree, void *key, void *value) {
+    // Find the leaf, counting the full inner nodes directly above it. If the
+    // leaf is full, each of them splits, and so does the root if every node
+    // on the path is full.
+    void *node = tree->root;
+    size_t full = 0;
+    for (size_t level = tree->height; level > 0; --level) {
+        BTreeInner *inner = node;
+        full = CS_BTREE_NODE_KEYS == inner->count ? full + 1 : 0;
+        node = inner->children[priv_btree_search(
+            tree, inner->keys, inner->count, key, 1)];
+    }
+
+    BTreeLeaf *leaf = node;
+    size_t index = priv_btree_search(tree, leaf->keys, leaf->count, key, 0);
+    if (index < leaf->count
+        && 0 == tree->comparator(&leaf->keys[index], &key)) {
+        void *replaced = leaf->values[index];
+        leaf->values[index] = value;
+        return (PointerResult){.ok = true, .value = replaced};
+    }
+
+    BTreeSpares spares = {0};
+    if (CS_BTREE_NODE_KEYS == leaf->count) {
+        size_t needed = full + 1 + (full == tree->height ? 1 : 0);
+        if (needed > CS_BTREE_MAX_HEIGHT + 2) {
+            return (PointerResult){
+                .ok = false, .error = SEASTAR_ERROR_INVALID_ARGUMENT};
+        }
+        for (size_t i = 0; i < needed; ++i) {
+            spares.nodes[i] = priv_btree_node(
+                0 == i ? sizeof(BTreeLeaf) : sizeof(BTreeInner));
+            if (NULL == spares.nodes[i]) {
+                int error = SEASTAR_ERRNO_SET | errno;
+                for (size_t j = 0; j < i; ++j) {
+                    free(spares.nodes[j]);
+                }
+                return (PointerResult){.ok = false, .error = error};
+            }
+        }
+    }
+
+    tree->size += 1;
+    BTreeSplit split = priv_btree_insert_node(
+        tree, tree->root, tree->height, key, value, &spares);
+    if (NULL != split.right) {
+        BTreeInner *root = spares.nodes[spares.next++];
+        root->count = 1;
+        root->keys[0] = split.separator;
+        root->children[0] = tree->root;
+        root->children[1] = split.right;
+        tree->root = root;
+        tree->height += 1;
+    }
+    return (PointerResult){.ok = true, .value = NULL};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_get
+//
+// DESCRIPTION:     Look up the value associated with key.
+//
+// ARGUMENTS:       key: The key to look up
+//
+// RETURN:          PointerResult containing the value, or
+//                  SEASTAR_ERROR_INVALID_INDEX if the key is not present.
+////
+PointerResult cs_btree_get(BTree *tree, void *key) {
+    BTreeLeaf *leaf = priv_btree_leaf(tree, key);
+    size_t index = priv_btree_search(tree, leaf->keys, leaf->count, key, 0);
+    if (index < leaf->count
+        && 0 == tree->comparator(&leaf->keys[index], &key)) {
+        return (PointerResult){.ok = true, .value = leaf->values[index]};
+    }
+
+    return (PointerResult){.ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_remove
+//
+// DESCRIPTION:     Remove key from the tree in O(log n).
+//
+// ARGUMENTS:       key: The key to remove
+//
+// RETURN:          PointerResult containing the removed value, or
+//                  SEASTAR_ERROR_INVALID_INDEX if the key is not present.
+////
+PointerResult cs_btree_remove(BTree *tree, void *key) {
+    PointerResult result =
+        priv_btree_remove_node(tree, tree->root, tree->height, key, NULL);
+    if (result.ok && tree->height > 0) {
+        BTreeInner *root = tree->root;
+        if (0 == root->count) {
+            tree->root = root->children[0];
+            tree->height -= 1;
+            free(root);
+        }
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_bulk_load
+//
+// DESCRIPTION:     Replace the contents of the tree, building it bottom-up in
+//                  O(n) from keys that are already sorted. Nodes are packed
+//                  as full as possible.
+//
+// ARGUMENTS:       keys: Keys in strictly ascending order
+//                  values: The value for each key
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_btree_bulk_load(BTree *tree, Vector *keys, Vector *values) {
+    if (keys->size != values->size) {
+        return (VoidResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_ARGUMENT};
+    }
+
+    // Each level is built as an array of nodes, along with the smallest key
+    // under each node, which becomes its separator in the level above.
+    size_t count = (keys->size + CS_BTREE_NODE_KEYS - 1) / CS_BTREE_NODE_KEYS;
+    if (0 == count) {
+        count = 1;
+    }
+    void **nodes = calloc(count, sizeof(void *));
+    void **lowest = calloc(count, sizeof(void *));
+    if (NULL == nodes || NULL == lowest) {
+        int error = errno;
+        free(nodes);
+        free(lowest);
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | error};
+    }
+
+    // Spread the entries evenly, so that no node is less than half full
+    size_t height = 0;
+    size_t entry = 0;
+    for (size_t i = 0; i < count; ++i) {
+        BTreeLeaf *leaf = priv_btree_node(sizeof(BTreeLeaf));
+        if (NULL == leaf) {
+            for (size_t j = 0; j < i; ++j) {
+                free(nodes[j]);
+            }
+            free(nodes);
+            free(lowest);
+            return (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | ENOMEM};
+        }
+        leaf->count = keys->size / count + (i < keys->size % count);
+        memcpy(leaf->keys, &keys->container[entry],
+            leaf->count * sizeof(void *));
+        memcpy(leaf->values, &values->container[entry],
+            leaf->count * sizeof(void *));
+        entry += leaf->count;
+        if (i > 0) {
+            ((BTreeLeaf *)nodes[i - 1])->next = leaf;
+        }
+        nodes[i] = leaf;
+        lowest[i] = leaf->keys[0];
+    }
+
+    while (count > 1) {
+        size_t children = count;
+        count = (children + CS_BTREE_NODE_KEYS) / (CS_BTREE_NODE_KEYS + 1);
+        size_t child = 0;
+        for (size_t i = 0; i < count; ++i) {
+            BTreeInner *inner = priv_btree_node(sizeof(BTreeInner));
+            if (NULL == inner) {
+                // Free the level being built, and the rest of the one below
+                for (size_t j = 0; j < i; ++j) {
+                    priv_btree_free_node(nodes[j], height + 1);
+                }
+                for (size_t j = child; j < children; ++j) {
+                    priv_btree_free_node(nodes[j], height);
+                }
+                free(nodes);
+                free(lowest);
+                return (VoidResult){
+                    .ok = false, .error = SEASTAR_ERRNO_SET | ENOMEM};
+            }
+            size_t fanout = children / count + (i < children % count);
+            inner->count = fanout - 1;
+            for (size_t j = 0; j < fanout; ++j) {
+                inner->children[j] = nodes[child + j];
+                if (j > 0) {
+                    inner->keys[j - 1] = lowest[child + j];
+                }
+            }
+            // Nodes below child have been consumed, so slot i is free
+            void *first = lowest[child];
+            child += fanout;
+            nodes[i] = inner;
+            lowest[i] = first;
+        }
+        height += 1;
+    }
+
+    cs_btree_free(tree);
+    tree->root = nodes[0];
+    tree->height = height;
+    tree->size = keys->size;
+    free(nodes);
+    free(lowest);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_free
+//
+// DESCRIPTION:     Free every node in the tree. Keys and values are owned by
+//                  the user, and are not touched.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_btree_free(BTree *tree) {
+    if (NULL != tree->root) {
+        priv_btree_free_node(tree->root, tree->height);
+        tree->root = NULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_range
+//
+// DESCRIPTION:     Find the range of keys between low and high, inclusive.
+//
+// ARGUMENTS:       low: The lowest key in the range, or NULL
+//                  high: The highest key in the range, or NULL
+//
+// RETURN:          BTreeRange
+////
+BTreeRange cs_btree_range(BTree *tree, void *low, void *high) {
+    BTreeRange range = {0};
+    range.tree = tree;
+    range.high = high;
+    if (NULL == low) {
+        void *node = tree->root;
+        for (size_t level = tree->height; level > 0; --level) {
+            node = ((BTreeInner *)node)->children[0];
+        }
+        range.leaf = node;
+        return range;
+    }
+
+    range.leaf = priv_btree_leaf(tree, low);
+    range.index =
+        priv_btree_search(tree, range.leaf->keys, range.leaf->count, low, 0);
+    return range;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_btree_range_iter
+//
+// DESCRIPTION:     Create an iterator over the values in a range, in key
+//                  order. The range must outlive the iterator, and values must
+//                  not be NULL. The tree must not be modified during
+//                  iteration.
+//
+// ARGUMENTS:       range: The range to iterate over
+//
+// RETURN:          Iterator
+////
+Iterator cs_btree_range_iter(BTreeRange *range) {
+    Iterator iter = {0};
+    iter.next = private_range_next;
+    iter.private = range;
+    return iter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
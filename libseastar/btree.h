@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            btree.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     In-memory B+-tree ordered map
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_BTREE_H
+#define SEASTAR_BTREE_H
+
+#include <stddef.h>
+
+#include <libseastar/iterator.h>
+#include <libseastar/pqueue.h>
+#include <libseastar/result.h>
+#include <libseastar/vector.h>
+
+// Every node holds up to this many keys, which makes both kinds of node
+// exactly four 64-byte cache lines on 64-bit platforms.
+#define CS_BTREE_NODE_KEYS 15
+
+struct BTreeLeaf;
+
+// BTree: Non-owning ordered map from keys to values, both user-provided
+// pointers. Keys are ordered by comparator, which (like all ComparisonFns) is
+// passed pointers to the two keys. Values live in leaves that are linked in
+// key order, so range scans walk the leaves sequentially. The tree keeps no
+// reference to a key once it has been removed, so the caller may free it.
+typedef struct BTree {
+    // NON USER CUSTOMIZABLE FIELDS
+    ComparisonFn *comparator;
+    size_t size;
+    size_t height;
+    void *root;
+} BTree;
+
+// A range of keys. Obtained from cs_btree_range, and iterated with
+// cs_btree_range_iter. After each call to cs_iter_next, key holds the key of
+// the value that was returned.
+typedef struct BTreeRange {
+    // NON USER CUSTOMIZABLE FIELDS
+    BTree *tree;
+    struct BTreeLeaf *leaf;
+    size_t index;
+    void *high;
+    void *key;
+} BTreeRange;
+
+// Initialize an empty tree
+VoidResult cs_btree_init(BTree *tree, ComparisonFn *comparator);
+
+// Insert or replace a value, returning the replaced value (or NULL)
+PointerResult cs_btree_insert(BTree *tree, void *key, void *value);
+
+// Look up/remove the value for a key
+PointerResult cs_btree_get(BTree *tree, void *key);
+PointerResult cs_btree_remove(BTree *tree, void *key);
+
+// Replace the contents of the tree with keys and values sorted by key
+VoidResult cs_btree_bulk_load(BTree *tree, Vector *keys, Vector *values);
+
+// Free internally allocated memory
+void cs_btree_free(BTree *tree);
+
+// The range of keys between low and high, inclusive. NULL bounds are open.
+BTreeRange cs_btree_range(BTree *tree, void *low, void *high);
+
+// Iterator over the values in a range, in key order
+Iterator cs_btree_range_iter(BTreeRange *range);
+
+#endif // SEASTAR_BTREE_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         11/13/2021
 //
-// LAST EDITED:     11/13/2021
+// LAST EDITED:     10/19/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -36,6 +36,12 @@ const char *cs_strerror(enum SeaStarError error) {
     switch (error) {
     case SEASTAR_ERROR_INVALID_INDEX:
         return "Index out of bounds for container";
+    case SEASTAR_ERROR_INVALID_ARGUMENT:
+        return "Argument out of range";
+    case SEASTAR_ERROR_NOT_SCHEDULED:
+        return "Timer is not scheduled";
+    case SEASTAR_ERROR_CONTENDED:
+        return "Operation lost a race with another thread";
     default:
         return "(null)";
     }
@@ -7,7 +7,7 @@
 //
 // CREATED:         11/13/2021
 //
-// LAST EDITED:     11/13/2021
+// LAST EDITED:     10/19/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -42,6 +42,10 @@
 enum SeaStarError {
     SEASTAR_ERRNO_SET = 1 << 16,           // errno is set in this result
     SEASTAR_ERROR_INVALID_INDEX = 2 << 16, // Attempt access on invalid index
+    // Each code is a single distinct bit, so results can be tested with &
+    SEASTAR_ERROR_INVALID_ARGUMENT = 4 << 16, // Argument out of range
+    SEASTAR_ERROR_NOT_SCHEDULED = 8 << 16,    // Timer is not pending
+    SEASTAR_ERROR_CONTENDED = 16 << 16,       // Lost a race, try again
 };
 
 const char *cs_strerror(enum SeaStarError);
@@ -0,0 +1,656 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            extqueue.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the external-memory priority queue
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+// For mkstemp and pread
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <libseastar/error.h>
+#include <libseastar/extqueue.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// A sorted run on disk, or a cursor over the rest of one. Records are read
+// with pread, so several cursors can read the same file independently.
+// head holds a copy of record next - 1, the least record not yet consumed,
+// and buffer holds records [first, first + count) of the file.
+typedef struct ExternalRun {
+    int fd;
+    size_t level;
+    size_t next;
+    size_t end;
+    char *head;
+    char *buffer;
+    size_t first;
+    size_t count;
+} ExternalRun;
+
+static inline char *priv_extqueue_record(ExternalQueue *queue, size_t index) {
+    return queue->buffer + index * queue->record_size;
+}
+
+// Number of records that fit in one block
+static inline size_t priv_extqueue_block_records(ExternalQueue *queue) {
+    size_t records = queue->block_size / queue->record_size;
+    return 0 == records ? 1 : records;
+}
+
+// Errors from short reads and writes don't set errno
+static int priv_extqueue_error(int error) {
+    return SEASTAR_ERRNO_SET | (0 != error ? error : EIO);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// In-memory heap
+////
+
+static void priv_extqueue_heap_push(ExternalQueue *queue, const void *record) {
+    size_t hole = queue->buffered++;
+    while (hole > 0) {
+        size_t parent = (hole - 1) / 2;
+        char *above = priv_extqueue_record(queue, parent);
+        if (queue->comparator(above, record) <= 0) {
+            break;
+        }
+        memcpy(priv_extqueue_record(queue, hole), above, queue->record_size);
+        hole = parent;
+    }
+    memcpy(priv_extqueue_record(queue, hole), record, queue->record_size);
+}
+
+// Remove the root of the heap, filling the hole from the bottom
+static void priv_extqueue_heap_pop(ExternalQueue *queue) {
+    size_t size = --queue->buffered;
+    if (0 == size) {
+        return;
+    }
+
+    char *last = queue->scratch;
+    memcpy(last, priv_extqueue_record(queue, size), queue->record_size);
+    size_t hole = 0;
+    while (2 * hole + 1 < size) {
+        size_t child = 2 * hole + 1;
+        if (child + 1 < size
+            && queue->comparator(priv_extqueue_record(queue, child + 1),
+                   priv_extqueue_record(queue, child)) < 0) {
+            child += 1;
+        }
+        char *below = priv_extqueue_record(queue, child);
+        if (queue->comparator(last, below) <= 0) {
+            break;
+        }
+        memcpy(priv_extqueue_record(queue, hole), below, queue->record_size);
+        hole = child;
+    }
+    memcpy(priv_extqueue_record(queue, hole), last, queue->record_size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// File I/O
+////
+
+// Open an unlinked temporary file in the queue's directory
+static int priv_extqueue_open(ExternalQueue *queue) {
+    static const char name[] = "/seastar-run-XXXXXX";
+    const char *directory = queue->directory;
+    if (NULL == directory) {
+        directory = getenv("TMPDIR");
+    }
+    if (NULL == directory || '\0' == *directory) {
+        directory = "/tmp";
+    }
+
+    char *path = malloc(strlen(directory) + sizeof(name));
+    if (NULL == path) {
+        return -1;
+    }
+    strcpy(path, directory);
+    strcat(path, name);
+    int fd = mkstemp(path);
+    if (-1 != fd) {
+        unlink(path);
+    }
+    free(path);
+    return fd;
+}
+
+static VoidResult priv_extqueue_write(int fd, const char *data, size_t bytes) {
+    while (bytes > 0) {
+        ssize_t written = write(fd, data, bytes);
+        if (written < 0 && EINTR == errno) {
+            continue;
+        } else if (written <= 0) {
+            return (VoidResult){
+                .ok = false, .error = priv_extqueue_error(errno)};
+        }
+        data += written;
+        bytes -= written;
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Runs
+////
+
+// Set up a cursor over records [next, end) of the file. The first of them is
+// not read until priv_extqueue_run_take.
+static VoidResult priv_extqueue_run_init(ExternalQueue *queue,
+    ExternalRun *run, int fd, size_t level, size_t next, size_t end) {
+    run->fd = fd;
+    run->level = level;
+    run->next = next;
+    run->end = end;
+    run->first = 0;
+    run->count = 0;
+    run->head = malloc(queue->record_size);
+    run->buffer =
+        malloc(priv_extqueue_block_records(queue) * queue->record_size);
+    if (NULL == run->head || NULL == run->buffer) {
+        int error = SEASTAR_ERRNO_SET | errno;
+        free(run->head);
+        free(run->buffer);
+        return (VoidResult){.ok = false, .error = error};
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+// Free the cursor's memory. The file is left open.
+static void priv_extqueue_run_release(ExternalRun *run) {
+    free(run->head);
+    free(run->buffer);
+}
+
+// Make sure record next is in the buffer, reading the next block if it is
+// not. On error, the head is left intact.
+static VoidResult priv_extqueue_run_fill(ExternalQueue *queue,
+    ExternalRun *run) {
+    if (run->next >= run->first && run->next < run->first + run->count) {
+        return (VoidResult){.ok = true, 0};
+    }
+
+    size_t records = priv_extqueue_block_records(queue);
+    if (run->end - run->next < records) {
+        records = run->end - run->next;
+    }
+    size_t bytes = records * queue->record_size;
+    off_t offset = (off_t)(run->next * queue->record_size);
+    size_t done = 0;
+    run->count = 0;
+    while (done < bytes) {
+        ssize_t length =
+            pread(run->fd, run->buffer + done, bytes - done, offset + done);
+        if (length < 0 && EINTR == errno) {
+            continue;
+        } else if (length <= 0) {
+            return (VoidResult){
+                .ok = false, .error = priv_extqueue_error(errno)};
+        }
+        done += length;
+    }
+    run->first = run->next;
+    run->count = records;
+    return (VoidResult){.ok = true, 0};
+}
+
+// Copy record next into the head. It must already be buffered.
+static void priv_extqueue_run_take(ExternalQueue *queue, ExternalRun *run) {
+    memcpy(run->head,
+        run->buffer + (run->next - run->first) * queue->record_size,
+        queue->record_size);
+    run->next += 1;
+}
+
+// Read the first record of a new cursor into its head
+static VoidResult priv_extqueue_run_start(ExternalQueue *queue,
+    ExternalRun *run) {
+    VoidResult result = priv_extqueue_run_fill(queue, run);
+    if (result.ok) {
+        priv_extqueue_run_take(queue, run);
+    }
+    return result;
+}
+
+// Arrays of runs are binary heaps ordered by the head of each run
+static void priv_extqueue_sift_up(ExternalQueue *queue, ExternalRun *runs,
+    size_t index) {
+    ExternalRun run = runs[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (queue->comparator(runs[parent].head, run.head) <= 0) {
+            break;
+        }
+        runs[index] = runs[parent];
+        index = parent;
+    }
+    runs[index] = run;
+}
+
+static void priv_extqueue_sift_down(ExternalQueue *queue, ExternalRun *runs,
+    size_t count, size_t index) {
+    ExternalRun run = runs[index];
+    while (2 * index + 1 < count) {
+        size_t child = 2 * index + 1;
+        if (child + 1 < count
+            && queue->comparator(runs[child + 1].head, runs[child].head) < 0) {
+            child += 1;
+        }
+        if (queue->comparator(run.head, runs[child].head) <= 0) {
+            break;
+        }
+        runs[index] = runs[child];
+        index = child;
+    }
+    runs[index] = run;
+}
+
+static void priv_extqueue_heapify(ExternalQueue *queue, ExternalRun *runs,
+    size_t count) {
+    for (size_t i = count / 2; i > 0; --i) {
+        priv_extqueue_sift_down(queue, runs, count, i - 1);
+    }
+}
+
+// Add a started run to the queue's heap of runs
+static VoidResult priv_extqueue_add_run(ExternalQueue *queue,
+    ExternalRun *run) {
+    if (queue->run_count == queue->run_capacity) {
+        size_t capacity = 0 == queue->run_capacity ? queue->fanin
+                                                   : 2 * queue->run_capacity;
+        ExternalRun *runs =
+            realloc(queue->runs, capacity * sizeof(ExternalRun));
+        if (NULL == runs) {
+            return (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | errno};
+        }
+        queue->runs = runs;
+        queue->run_capacity = capacity;
+    }
+
+    queue->runs[queue->run_count++] = *run;
+    priv_extqueue_sift_up(queue, queue->runs, queue->run_count - 1);
+    return (VoidResult){.ok = true, 0};
+}
+
+static size_t priv_extqueue_level_count(ExternalQueue *queue, size_t level) {
+    size_t count = 0;
+    for (size_t i = 0; i < queue->run_count; ++i) {
+        count += level == queue->runs[i].level;
+    }
+    return count;
+}
+
+// Merge the first fanin runs on the level into one run on the next level.
+// The sources are read through cursors of their own, and are only closed
+// once the merged run is complete, so a failure leaves the queue unchanged.
+static VoidResult priv_extqueue_merge(ExternalQueue *queue, size_t level) {
+    const size_t fanin = queue->fanin;
+    ExternalRun *cursors = calloc(fanin, sizeof(ExternalRun));
+    ExternalRun merged = {.fd = -1};
+    size_t block = priv_extqueue_block_records(queue) * queue->record_size;
+    char *output = malloc(block);
+    if (NULL == cursors || NULL == output) {
+        int error = SEASTAR_ERRNO_SET | errno;
+        free(cursors);
+        free(output);
+        return (VoidResult){.ok = false, .error = error};
+    }
+
+    VoidResult result = {.ok = true, 0};
+    size_t count = 0;
+    size_t total = 0;
+    for (size_t i = 0; i < queue->run_count && count < fanin && result.ok;
+         ++i) {
+        ExternalRun *source = &queue->runs[i];
+        if (level != source->level) {
+            continue;
+        }
+        result = priv_extqueue_run_init(queue, &cursors[count], source->fd,
+            level, source->next - 1, source->end);
+        if (result.ok) {
+            count += 1;
+            result = priv_extqueue_run_start(queue, &cursors[count - 1]);
+            total += source->end - source->next + 1;
+        }
+    }
+
+    if (result.ok) {
+        merged.fd = priv_extqueue_open(queue);
+        if (-1 == merged.fd) {
+            result = (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | errno};
+        }
+    }
+
+    // Stream the cursors through a heap into the output file
+    size_t active = count;
+    size_t pending = 0;
+    if (result.ok) {
+        priv_extqueue_heapify(queue, cursors, active);
+    }
+    while (result.ok && active > 0) {
+        ExternalRun *least = &cursors[0];
+        memcpy(output + pending, least->head, queue->record_size);
+        pending += queue->record_size;
+        if (pending == block) {
+            result = priv_extqueue_write(merged.fd, output, pending);
+            pending = 0;
+        }
+
+        if (least->next == least->end) {
+            ExternalRun done = *least;
+            *least = cursors[--active];
+            cursors[active] = done;
+        } else {
+            VoidResult filled = priv_extqueue_run_fill(queue, least);
+            if (!filled.ok) {
+                result = filled;
+                break;
+            }
+            priv_extqueue_run_take(queue, least);
+        }
+        if (active > 0) {
+            priv_extqueue_sift_down(queue, cursors, active, 0);
+        }
+    }
+    if (result.ok && pending > 0) {
+        result = priv_extqueue_write(merged.fd, output, pending);
+    }
+    if (result.ok) {
+        result = priv_extqueue_run_init(
+            queue, &merged, merged.fd, level + 1, 0, total);
+        if (result.ok) {
+            result = priv_extqueue_run_start(queue, &merged);
+            if (!result.ok) {
+                priv_extqueue_run_release(&merged);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        priv_extqueue_run_release(&cursors[i]);
+    }
+    free(cursors);
+    free(output);
+    if (!result.ok) {
+        if (-1 != merged.fd) {
+            close(merged.fd);
+        }
+        return result;
+    }
+
+    // Close the sources, and put the merged run in their place
+    size_t kept = 0;
+    size_t closed = 0;
+    for (size_t i = 0; i < queue->run_count; ++i) {
+        ExternalRun *run = &queue->runs[i];
+        if (level == run->level && closed < fanin) {
+            close(run->fd);
+            priv_extqueue_run_release(run);
+            closed += 1;
+        } else {
+            queue->runs[kept++] = *run;
+        }
+    }
+    queue->runs[kept++] = merged;
+    queue->run_count = kept;
+    priv_extqueue_heapify(queue, queue->runs, queue->run_count);
+    return result;
+}
+
+// Sort the in-memory buffer and write it out as a new run on level 0, then
+// merge any level that has filled up. A sorted array is also a valid heap,
+// so the buffer is left intact if the run can't be written.
+static VoidResult priv_extqueue_spill(ExternalQueue *queue) {
+    if (queue->fanin < 2) {
+        queue->fanin = 2;
+    }
+    qsort(queue->buffer, queue->buffered, queue->record_size,
+        queue->comparator);
+
+    ExternalRun run;
+    int fd = priv_extqueue_open(queue);
+    if (-1 == fd) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+    VoidResult result = priv_extqueue_write(
+        fd, queue->buffer, queue->buffered * queue->record_size);
+    if (result.ok) {
+        result = priv_extqueue_run_init(queue, &run, fd, 0, 0, queue->buffered);
+        if (result.ok) {
+            result = priv_extqueue_run_start(queue, &run);
+            if (result.ok) {
+                result = priv_extqueue_add_run(queue, &run);
+            }
+            if (!result.ok) {
+                priv_extqueue_run_release(&run);
+            }
+        }
+    }
+    if (!result.ok) {
+        close(fd);
+        return result;
+    }
+    queue->buffered = 0;
+
+    // Merge full levels from the bottom up. This also catches up on merges
+    // that failed after earlier spills. If one fails again, it is retried
+    // after the next spill.
+    size_t level = 0;
+    size_t runs = queue->run_count;
+    while (runs > 0) {
+        size_t count = priv_extqueue_level_count(queue, level);
+        if (count >= queue->fanin) {
+            if (!priv_extqueue_merge(queue, level).ok) {
+                break;
+            }
+            runs -= queue->fanin;
+            runs += 1;
+            continue;
+        }
+        runs -= count;
+        level += 1;
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_extqueue_init
+//
+// DESCRIPTION:     Initialize an empty queue. Nothing is written to disk until
+//                  the in-memory buffer fills up.
+//
+// ARGUMENTS:       record_size: The size of each record
+//                  budget: Size in bytes of the in-memory buffer
+//                  comparator: Compares two records, given pointers to them
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_extqueue_init(ExternalQueue *queue, size_t record_size,
+    size_t budget, ComparisonFn *comparator) {
+    if (0 == record_size || budget < record_size) {
+        return (VoidResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_ARGUMENT};
+    }
+
+    queue->directory = NULL;
+    queue->fanin = CS_EXTQUEUE_DEFAULT_FANIN;
+    queue->block_size = CS_EXTQUEUE_DEFAULT_BLOCK_SIZE;
+    queue->comparator = comparator;
+    queue->record_size = record_size;
+    queue->size = 0;
+    queue->capacity = budget / record_size;
+    queue->buffered = 0;
+    queue->runs = NULL;
+    queue->run_count = 0;
+    queue->run_capacity = 0;
+    queue->buffer = malloc(queue->capacity * record_size);
+    queue->scratch = malloc(record_size);
+    if (NULL == queue->buffer || NULL == queue->scratch) {
+        int error = SEASTAR_ERRNO_SET | errno;
+        free(queue->buffer);
+        free(queue->scratch);
+        return (VoidResult){.ok = false, .error = error};
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_extqueue_push
+//
+// DESCRIPTION:     Copy the record into the in-memory heap. If the heap is
+//                  full, it is first written out as a new run.
+//
+// ARGUMENTS:       record: The record to copy
+//
+// RETURN:          VoidResult. If a run could not be written, the record is
+//                  not pushed.
+////
+VoidResult cs_extqueue_push(ExternalQueue *queue, const void *record) {
+    if (queue->buffered == queue->capacity) {
+        VoidResult result = priv_extqueue_spill(queue);
+        if (!result.ok) {
+            return result;
+        }
+    }
+
+    priv_extqueue_heap_push(queue, record);
+    queue->size += 1;
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_extqueue_peek
+//
+// DESCRIPTION:     Peek at the least record, which is either the root of the
+//                  in-memory heap or the head of a run.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          PointerResult containing a pointer to the record.
+////
+PointerResult cs_extqueue_peek(ExternalQueue *queue) {
+    if (0 == queue->buffered && 0 == queue->run_count) {
+        return (PointerResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    } else if (0 == queue->run_count
+        || (0 != queue->buffered
+            && queue->comparator(queue->buffer, queue->runs[0].head) <= 0)) {
+        return (PointerResult){.ok = true, .value = queue->buffer};
+    }
+    return (PointerResult){.ok = true, .value = queue->runs[0].head};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_extqueue_pop
+//
+// DESCRIPTION:     Copy out and remove the least record. Popping the head of
+//                  a run reads the next record of that run, a block at a
+//                  time.
+//
+// ARGUMENTS:       record: Buffer of record_size bytes to copy into
+//
+// RETURN:          VoidResult. If the next record of a run could not be read,
+//                  nothing is removed, and the pop may be retried.
+////
+VoidResult cs_extqueue_pop(ExternalQueue *queue, void *record) {
+    PointerResult least = cs_extqueue_peek(queue);
+    if (!least.ok) {
+        return (VoidResult){.ok = false, .error = least.error};
+    } else if (least.value == queue->buffer) {
+        memcpy(record, least.value, queue->record_size);
+        priv_extqueue_heap_pop(queue);
+        queue->size -= 1;
+        return (VoidResult){.ok = true, 0};
+    }
+
+    // Read the run's next record before anything is removed, so that an I/O
+    // error leaves the queue as it was
+    ExternalRun *run = &queue->runs[0];
+    if (run->next < run->end) {
+        VoidResult result = priv_extqueue_run_fill(queue, run);
+        if (!result.ok) {
+            return result;
+        }
+    }
+
+    memcpy(record, run->head, queue->record_size);
+    queue->size -= 1;
+    if (run->next < run->end) {
+        priv_extqueue_run_take(queue, run);
+    } else {
+        close(run->fd);
+        priv_extqueue_run_release(run);
+        *run = queue->runs[--queue->run_count];
+    }
+    if (queue->run_count > 0) {
+        priv_extqueue_sift_down(queue, queue->runs, queue->run_count, 0);
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_extqueue_free
+//
+// DESCRIPTION:     Close every run, which deletes its file, and free internal
+//                  memory.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_extqueue_free(ExternalQueue *queue) {
+    for (size_t i = 0; i < queue->run_count; ++i) {
+        close(queue->runs[i].fd);
+        priv_extqueue_run_release(&queue->runs[i]);
+    }
+    free(queue->runs);
+    free(queue->buffer);
+    free(queue->scratch);
+    queue->runs = NULL;
+    queue->run_count = 0;
+    queue->run_capacity = 0;
+    queue->buffered = 0;
+    queue->size = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
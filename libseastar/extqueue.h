@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            extqueue.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Priority queue that spills sorted runs to disk
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_EXTQUEUE_H
+#define SEASTAR_EXTQUEUE_H
+
+#include <stddef.h>
+
+#include <libseastar/pqueue.h>
+#include <libseastar/result.h>
+
+static const size_t CS_EXTQUEUE_DEFAULT_FANIN = 64;
+static const size_t CS_EXTQUEUE_DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+struct ExternalRun;
+
+// ExternalQueue: Priority queue of fixed-size records that may hold more
+// records than fit in memory. Pushed records are copied into a binary heap of
+// at most budget bytes. When the heap is full, it is sorted and written out
+// to an unlinked temporary file as a run. Pops take the least of the heap and
+// the heads of the runs, reading each run sequentially through a buffer of
+// block_size bytes.
+//
+// Runs are merged in tiers: spilled runs are on level 0, and once a level
+// has fanin runs, they are merged into one run on the next level. Each record
+// is therefore rewritten about log_fanin(records / budget) times. A merge
+// that fails (e.g. with ENOSPC) leaves its runs in place, and is retried
+// after the next spill, so there are normally at most fanin - 1 runs per
+// level. Besides the budget, each run holds one block, and a merge holds
+// fanin + 1 more while it runs.
+//
+// Unlike PriorityQueue, the queue owns copies of its records, and the
+// comparator is passed pointers to records rather than pointers to pointers.
+// Like PriorityQueue, records are popped least first, and the order of
+// records that compare equal is unspecified.
+typedef struct ExternalQueue {
+    // USER CUSTOMIZABLE FIELDS
+    // Directory to write runs to. If NULL, $TMPDIR, or /tmp if it is unset.
+    const char *directory;
+    // Number of runs on a level that are merged into one
+    size_t fanin;
+    // Size of the I/O buffer for each run
+    size_t block_size;
+
+    // NON USER CUSTOMIZABLE FIELDS
+    ComparisonFn *comparator;
+    size_t record_size;
+    size_t size;
+    size_t capacity;
+    size_t buffered;
+    char *buffer;
+    char *scratch;
+    struct ExternalRun *runs;
+    size_t run_count;
+    size_t run_capacity;
+} ExternalQueue;
+
+// Initialize a queue of record_size records, buffering up to budget bytes of
+// them in memory. The budget must hold at least one record.
+VoidResult cs_extqueue_init(ExternalQueue *queue, size_t record_size,
+    size_t budget, ComparisonFn *comparator);
+
+// Copy a record into the queue, spilling the buffer to disk if it is full. On
+// error, the record is not pushed, and the queue is unchanged.
+VoidResult cs_extqueue_push(ExternalQueue *queue, const void *record);
+
+// Peek at the least record. The pointer is valid until the next push or pop.
+PointerResult cs_extqueue_peek(ExternalQueue *queue);
+
+// Copy the least record into record, and remove it from the queue. On error,
+// the queue is unchanged.
+VoidResult cs_extqueue_pop(ExternalQueue *queue, void *record);
+
+// Close every run and free internally allocated memory
+void cs_extqueue_free(ExternalQueue *queue);
+
+#endif // SEASTAR_EXTQUEUE_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         11/13/2021
 //
-// LAST EDITED:     11/13/2021
+// LAST EDITED:     10/19/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -42,7 +42,7 @@
 // RETURN:          Return the next element in the iterator, or NULL
 ////
 void *cs_iter_next(Iterator *iterator) {
-    return iterator->next(iterator->private, &iterator->state);
+    return cs_iter_next_inline(iterator);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
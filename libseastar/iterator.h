@@ -7,7 +7,7 @@
 //
 // CREATED:         11/13/2021
 //
-// LAST EDITED:     11/13/2021
+// LAST EDITED:     10/19/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -56,6 +56,16 @@ typedef struct Iterator {
 // Return the next element in this iterator
 void *cs_iter_next(Iterator *iterator);
 
+// Inline version of cs_iter_next, for hot loops. Define SEASTAR_INLINE to use
+// it in place of cs_iter_next.
+static inline void *cs_iter_next_inline(Iterator *iterator) {
+    return iterator->next(iterator->private, &iterator->state);
+}
+
+#if defined(SEASTAR_INLINE) && !defined(SEASTAR_BUILD)
+#define cs_iter_next(iterator) cs_iter_next_inline(iterator)
+#endif
+
 #endif // SEASTAR_ITERATOR_H
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            merge.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the loser tree merge
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <libseastar/error.h>
+#include <libseastar/merge.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// The loser tree is stored implicitly: leaf i lives at position count + i,
+// internal node n has children 2n and 2n + 1, and tree[n] holds the index of
+// the source that lost the match played at node n. tree[0] holds the overall
+// winner. An exhausted source (head == NULL) loses to every other source.
+
+// Return true if source one should be yielded before source two
+static bool priv_merge_less(MergeIterator *merge, size_t one, size_t two) {
+    void *first = merge->heads[one];
+    void *second = merge->heads[two];
+    if (NULL == first) {
+        return false;
+    } else if (NULL == second) {
+        return true;
+    }
+
+    int result = merge->comparator(&first, &second);
+    return result < 0 || (0 == result && one < two);
+}
+
+// Play every match in the subtree rooted at node, returning the winner
+static size_t priv_merge_build(MergeIterator *merge, size_t node) {
+    if (node >= merge->count) {
+        return node - merge->count;
+    }
+
+    size_t left = priv_merge_build(merge, 2 * node);
+    size_t right = priv_merge_build(merge, 2 * node + 1);
+    if (priv_merge_less(merge, left, right)) {
+        merge->tree[node] = right;
+        return left;
+    }
+
+    merge->tree[node] = left;
+    return right;
+}
+
+// Replay the matches on the path from a leaf to the root
+static void priv_merge_replay(MergeIterator *merge, size_t source) {
+    size_t winner = source;
+    for (size_t node = (source + merge->count) / 2; node > 0; node /= 2) {
+        if (priv_merge_less(merge, merge->tree[node], winner)) {
+            size_t loser = winner;
+            winner = merge->tree[node];
+            merge->tree[node] = loser;
+        }
+    }
+    merge->tree[0] = winner;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        private_iter_next
+//
+// DESCRIPTION:     Return the next element in the merged sequence.
+//
+// ARGUMENTS:       private: The MergeIterator*
+//                  state: Unused
+//
+// RETURN:          The next element, or NULL.
+////
+static void *private_iter_next(void *private, union IteratorState *state) {
+    (void)state;
+    MergeIterator *merge = (MergeIterator *)private;
+    if (0 == merge->count) {
+        return NULL;
+    }
+
+    size_t winner = merge->tree[0];
+    void *value = merge->heads[winner];
+    if (NULL == value) {
+        return NULL;
+    }
+
+    merge->heads[winner] = cs_iter_next(&merge->sources[winner]);
+    priv_merge_replay(merge, winner);
+    return value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_merge_init
+//
+// DESCRIPTION:     Initialize the merge, pulling the first element from each
+//                  source and playing the initial tournament.
+//
+// ARGUMENTS:       sources: Array of count sorted iterators
+//                  count: Number of sources
+//                  comparator: The comparator the sources are sorted by
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_merge_init(MergeIterator *merge, Iterator *sources, size_t count,
+    ComparisonFn *comparator) {
+    merge->comparator = comparator;
+    merge->count = count;
+    merge->sources = NULL;
+    merge->heads = NULL;
+    merge->tree = NULL;
+    if (0 == count) {
+        return (VoidResult){.ok = true, 0};
+    }
+
+    merge->sources = malloc(count * sizeof(Iterator));
+    merge->heads = malloc(count * sizeof(void *));
+    merge->tree = malloc(count * sizeof(size_t));
+    if (NULL == merge->sources || NULL == merge->heads
+        || NULL == merge->tree) {
+        int error = errno;
+        cs_merge_free(merge);
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | error};
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        merge->sources[i] = sources[i];
+        merge->heads[i] = cs_iter_next(&merge->sources[i]);
+    }
+
+    merge->tree[0] = priv_merge_build(merge, 1);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_merge_free
+//
+// DESCRIPTION:     Free internally allocated memory for the merge. The sources
+//                  themselves are not touched.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_merge_free(MergeIterator *merge) {
+    free(merge->sources);
+    free(merge->heads);
+    free(merge->tree);
+    merge->sources = NULL;
+    merge->heads = NULL;
+    merge->tree = NULL;
+    merge->count = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_merge_iter
+//
+// DESCRIPTION:     Create an iterator that lazily yields the merged sequence.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          Iterator
+////
+Iterator cs_merge_iter(MergeIterator *merge) {
+    Iterator iter = {0};
+    iter.next = private_iter_next;
+    iter.private = merge;
+    return iter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
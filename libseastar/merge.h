@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            merge.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Lazy K-way merge of sorted iterators using a loser tree
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_MERGE_H
+#define SEASTAR_MERGE_H
+
+#include <stddef.h>
+
+#include <libseastar/iterator.h>
+#include <libseastar/pqueue.h>
+#include <libseastar/result.h>
+
+// MergeIterator: Yields the elements of K sorted sources in merged order,
+// using a tournament (loser) tree. Each element costs about log2(K)
+// comparisons, and no memory is allocated after initialization. Elements that
+// compare equal are yielded in source order, so the merge is stable. The
+// sources must already be sorted by the same comparator, and must outlive the
+// MergeIterator.
+typedef struct MergeIterator {
+    // NON USER CUSTOMIZABLE FIELDS
+    ComparisonFn *comparator;
+    size_t count;
+    Iterator *sources;
+    void **heads;
+    size_t *tree;
+} MergeIterator;
+
+// Initialize a merge over count iterators. The iterators are copied.
+VoidResult cs_merge_init(MergeIterator *merge, Iterator *sources, size_t count,
+    ComparisonFn *comparator);
+
+// Free internally allocated memory
+void cs_merge_free(MergeIterator *merge);
+
+// Create an iterator that yields the merged sequence
+Iterator cs_merge_iter(MergeIterator *merge);
+
+#endif // SEASTAR_MERGE_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,399 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            parallel.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the thread pool and parallel operations
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <libseastar/error.h>
+#include <libseastar/parallel.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// One parallel operation. The elements are divided into chunks, and run is
+// called once for each chunk.
+typedef struct ParallelJob {
+    void (*run)(struct ParallelJob *job, size_t chunk, size_t begin,
+        size_t end);
+    ParallelSchedule schedule;
+    size_t size;
+    size_t grain;
+    size_t chunks;
+    atomic_size_t next;
+
+    Vector *source;
+    Vector *destination;
+    VisitFn *visitor;
+    MapFn *map;
+    ReduceFn *reduce;
+    void *identity;
+    void *context;
+    void **partials;
+} ParallelJob;
+
+// Bounds of a chunk
+static void priv_parallel_bounds(ParallelJob *job, size_t chunk,
+    size_t *begin, size_t *end) {
+    if (CS_PARALLEL_STATIC == job->schedule) {
+        *begin = chunk * job->size / job->chunks;
+        *end = (chunk + 1) * job->size / job->chunks;
+    } else {
+        *begin = chunk * job->grain;
+        *end = *begin + job->grain < job->size ? *begin + job->grain
+                                               : job->size;
+    }
+}
+
+// Work on the job as the participant with the given id (0 is the caller)
+static void priv_parallel_participate(ParallelJob *job, size_t id) {
+    size_t begin = 0;
+    size_t end = 0;
+    if (CS_PARALLEL_STATIC == job->schedule) {
+        if (id < job->chunks) {
+            priv_parallel_bounds(job, id, &begin, &end);
+            job->run(job, id, begin, end);
+        }
+        return;
+    }
+
+    while (true) {
+        size_t chunk = atomic_fetch_add_explicit(
+            &job->next, 1, memory_order_relaxed);
+        if (chunk >= job->chunks) {
+            return;
+        }
+        priv_parallel_bounds(job, chunk, &begin, &end);
+        job->run(job, chunk, begin, end);
+    }
+}
+
+static void *priv_parallel_worker(void *argument) {
+    ThreadPool *pool = argument;
+    pthread_mutex_lock(&pool->lock);
+    size_t id = ++pool->active;
+    size_t generation = pool->generation;
+    pthread_cond_signal(&pool->done);
+
+    while (true) {
+        while (!pool->stopping && generation == pool->generation) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+
+        generation = pool->generation;
+        ParallelJob *job = pool->job;
+        pthread_mutex_unlock(&pool->lock);
+        priv_parallel_participate(job, id);
+        pthread_mutex_lock(&pool->lock);
+        if (0 == --pool->active) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+}
+
+// Decide how the job is divided into chunks
+static void priv_parallel_plan(ThreadPool *pool, ParallelJob *job) {
+    job->schedule = pool->schedule;
+    job->grain = 0 == pool->grain ? 1 : pool->grain;
+    atomic_init(&job->next, 0);
+    if (job->size <= job->grain || 0 == pool->size) {
+        job->schedule = CS_PARALLEL_STATIC;
+        job->chunks = 1;
+    } else if (CS_PARALLEL_STATIC == job->schedule) {
+        job->chunks = pool->size + 1;
+    } else {
+        job->chunks = (job->size + job->grain - 1) / job->grain;
+    }
+}
+
+// Run a planned job on the pool, returning once every chunk has been run
+static void priv_parallel_submit(ThreadPool *pool, ParallelJob *job) {
+    if (1 == job->chunks) {
+        job->run(job, 0, 0, job->size);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->submit);
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->generation += 1;
+    pool->active = pool->size;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    priv_parallel_participate(job, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (0 != pool->active) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->job = NULL;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->submit);
+}
+
+static void priv_parallel_run_for_each(ParallelJob *job, size_t chunk,
+    size_t begin, size_t end) {
+    (void)chunk;
+    void **container = job->source->container;
+    for (size_t i = begin; i < end; ++i) {
+        job->visitor(container[i], job->context);
+    }
+}
+
+static void priv_parallel_run_map(ParallelJob *job, size_t chunk,
+    size_t begin, size_t end) {
+    (void)chunk;
+    void **from = job->source->container;
+    void **to = job->destination->container;
+    for (size_t i = begin; i < end; ++i) {
+        to[i] = job->map(from[i], job->context);
+    }
+}
+
+static void priv_parallel_run_reduce(ParallelJob *job, size_t chunk,
+    size_t begin, size_t end) {
+    void **container = job->source->container;
+    void *accumulator = job->identity;
+    for (size_t i = begin; i < end; ++i) {
+        accumulator = job->reduce(accumulator, container[i], job->context);
+    }
+    job->partials[chunk] = accumulator;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_threadpool_init
+//
+// DESCRIPTION:     Initialize the pool, starting threads - 1 worker threads.
+//                  The pool uses CS_PARALLEL_DYNAMIC scheduling and a grain of
+//                  CS_THREADPOOL_DEFAULT_GRAIN by default.
+//
+// ARGUMENTS:       threads: Total number of threads to share work between, or
+//                      0 for the number of online CPUs
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_threadpool_init(ThreadPool *pool, size_t threads) {
+    if (0 == threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t)online : 1;
+    }
+
+    pool->schedule = CS_PARALLEL_DYNAMIC;
+    pool->grain = CS_THREADPOOL_DEFAULT_GRAIN;
+    pool->size = 0;
+    pool->job = NULL;
+    pool->generation = 0;
+    pool->active = 0;
+    pool->stopping = false;
+    pool->threads = calloc(threads, sizeof(pthread_t));
+    if (NULL == pool->threads) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    pthread_mutex_init(&pool->submit, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    // Wait for each worker to take its id before starting the next, so that
+    // active counts the workers up from 0.
+    pthread_mutex_lock(&pool->lock);
+    for (size_t i = 0; i < threads - 1; ++i) {
+        int error =
+            pthread_create(&pool->threads[i], NULL, priv_parallel_worker, pool);
+        if (0 != error) {
+            pthread_mutex_unlock(&pool->lock);
+            cs_threadpool_free(pool);
+            return (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | error};
+        }
+        pool->size += 1;
+        while (pool->active != pool->size) {
+            pthread_cond_wait(&pool->done, &pool->lock);
+        }
+    }
+    pool->active = 0;
+    pthread_mutex_unlock(&pool->lock);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_threadpool_free
+//
+// DESCRIPTION:     Stop and join every worker thread, and free internal
+//                  memory. No operation may be running on the pool.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_threadpool_free(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->size; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    free(pool->threads);
+    pool->threads = NULL;
+    pool->size = 0;
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->submit);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_vector_parallel_for_each
+//
+// DESCRIPTION:     Call visitor on every element of the vector, spread across
+//                  the pool. Elements are visited in no particular order, and
+//                  the visitor may be called from several threads at once.
+//
+// ARGUMENTS:       pool: The pool to run on
+//                  visitor: Function to call on each element
+//                  context: Passed through to the visitor
+//
+// RETURN:          none
+////
+void cs_vector_parallel_for_each(ThreadPool *pool, Vector *vector,
+    VisitFn *visitor, void *context) {
+    ParallelJob job = {0};
+    job.run = priv_parallel_run_for_each;
+    job.size = vector->size;
+    job.source = vector;
+    job.visitor = visitor;
+    job.context = context;
+    priv_parallel_plan(pool, &job);
+    priv_parallel_submit(pool, &job);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_vector_parallel_map
+//
+// DESCRIPTION:     Compute destination[i] = map(source[i]) for every element,
+//                  spread across the pool. Destination is grown or shrunk to
+//                  the size of source first; any elements it held are
+//                  overwritten.
+//
+// ARGUMENTS:       pool: The pool to run on
+//                  source: The vector to read from
+//                  destination: The vector to write to
+//                  map: Function computing each destination element
+//                  context: Passed through to map
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_vector_parallel_map(ThreadPool *pool, Vector *source,
+    Vector *destination, MapFn *map, void *context) {
+    if (source == destination) {
+        return (VoidResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_ARGUMENT};
+    }
+
+    destination->size = destination->size < source->size
+        ? destination->size
+        : source->size;
+    while (destination->size < source->size) {
+        IndexResult result = cs_vector_push_back(destination, NULL);
+        if (!result.ok) {
+            return (VoidResult){.ok = false, .error = result.error};
+        }
+    }
+
+    ParallelJob job = {0};
+    job.run = priv_parallel_run_map;
+    job.size = source->size;
+    job.source = source;
+    job.destination = destination;
+    job.map = map;
+    job.context = context;
+    priv_parallel_plan(pool, &job);
+    priv_parallel_submit(pool, &job);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_vector_parallel_reduce
+//
+// DESCRIPTION:     Fold every element of the vector into an accumulator. Each
+//                  chunk is reduced starting from identity, and the results
+//                  are combined from left to right, so combine must be
+//                  associative, but need not be commutative.
+//
+// ARGUMENTS:       pool: The pool to run on
+//                  reduce: Function folding an element into an accumulator
+//                  combine: Function merging two accumulators
+//                  identity: The initial value of each accumulator
+//                  context: Passed through to reduce and combine
+//
+// RETURN:          PointerResult containing the final accumulator.
+////
+PointerResult cs_vector_parallel_reduce(ThreadPool *pool, Vector *vector,
+    ReduceFn *reduce, CombineFn *combine, void *identity, void *context) {
+    ParallelJob job = {0};
+    job.run = priv_parallel_run_reduce;
+    job.size = vector->size;
+    job.source = vector;
+    job.reduce = reduce;
+    job.identity = identity;
+    job.context = context;
+    priv_parallel_plan(pool, &job);
+    job.partials = calloc(job.chunks, sizeof(void *));
+    if (NULL == job.partials) {
+        return (PointerResult){
+            .ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+    priv_parallel_submit(pool, &job);
+
+    void *accumulator = job.partials[0];
+    for (size_t i = 1; i < job.chunks; ++i) {
+        accumulator = combine(accumulator, job.partials[i], context);
+    }
+    free(job.partials);
+    return (PointerResult){.ok = true, .value = accumulator};
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            parallel.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Thread pool and parallel operations over vectors
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_PARALLEL_H
+#define SEASTAR_PARALLEL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <libseastar/result.h>
+#include <libseastar/vector.h>
+
+static const size_t CS_THREADPOOL_DEFAULT_GRAIN = 1024;
+
+// How the elements of a vector are divided between threads
+typedef enum ParallelSchedule {
+    // One contiguous chunk per thread. Best when every element costs the same.
+    CS_PARALLEL_STATIC,
+    // Threads take chunks of grain elements as they finish their last one.
+    CS_PARALLEL_DYNAMIC,
+} ParallelSchedule;
+
+// Function used by cs_vector_parallel_map to compute each destination element
+typedef void *MapFn(void *user_data, void *context);
+
+// Functions used by cs_vector_parallel_reduce. ReduceFn folds an element into
+// an accumulator, and CombineFn merges the accumulators of two adjacent
+// chunks. Both return the new accumulator.
+typedef void *ReduceFn(void *accumulator, void *user_data, void *context);
+typedef void *CombineFn(void *left, void *right, void *context);
+
+struct ParallelJob;
+
+// ThreadPool: A persistent set of worker threads. Each parallel operation
+// divides the vector into chunks according to schedule and grain, and the
+// calling thread works on chunks alongside the workers until the operation is
+// finished. Operations submitted from several threads run one at a time.
+typedef struct ThreadPool {
+    // USER CUSTOMIZABLE FIELDS
+    ParallelSchedule schedule;
+    // Vectors of at most this many elements are processed on the calling
+    // thread alone. Also the chunk size for CS_PARALLEL_DYNAMIC.
+    size_t grain;
+
+    // NON USER CUSTOMIZABLE FIELDS
+    size_t size;
+    pthread_t *threads;
+    pthread_mutex_t submit;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    struct ParallelJob *job;
+    size_t generation;
+    size_t active;
+    bool stopping;
+} ThreadPool;
+
+// Initialize a pool in which threads threads (including the caller of each
+// operation) share the work. 0 selects the number of online CPUs.
+VoidResult cs_threadpool_init(ThreadPool *pool, size_t threads);
+
+// Stop and join the worker threads
+void cs_threadpool_free(ThreadPool *pool);
+
+// Call visitor on every element of the vector, in no particular order
+void cs_vector_parallel_for_each(ThreadPool *pool, Vector *vector,
+    VisitFn *visitor, void *context);
+
+// Set destination[i] = map(source[i]) for every element, resizing
+// destination to the size of source
+VoidResult cs_vector_parallel_map(ThreadPool *pool, Vector *source,
+    Vector *destination, MapFn *map, void *context);
+
+// Fold every element of the vector into identity, returning the result
+PointerResult cs_vector_parallel_reduce(ThreadPool *pool, Vector *vector,
+    ReduceFn *reduce, CombineFn *combine, void *identity, void *context);
+
+#endif // SEASTAR_PARALLEL_H
+
+///////////////////////////////////////////////////////////////////////////////
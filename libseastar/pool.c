@@ -0,0 +1,289 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            pool.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the object pool
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <libseastar/error.h>
+#include <libseastar/pool.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// Each slab begins with a header linking it to the previous slab, padded so
+// that the objects which follow it are suitably aligned.
+typedef union PoolSlab {
+    union PoolSlab *next;
+    max_align_t align;
+} PoolSlab;
+
+// Free objects store the free list link in their first word
+static void *priv_pool_next(void *object) { return *(void **)object; }
+
+static void priv_pool_link(void *object, void *next) {
+    *(void **)object = next;
+}
+
+// Allocate a new slab, making it the source of unused objects
+static VoidResult priv_pool_grow(ObjectPool *pool) {
+    PoolSlab *slab =
+        malloc(sizeof(PoolSlab) + pool->slab_size * pool->object_size);
+    if (NULL == slab) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->unused = (char *)(slab + 1);
+    pool->unused_end = pool->unused + pool->slab_size * pool->object_size;
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_init
+//
+// DESCRIPTION:     Initialize an empty pool. No slabs are allocated until the
+//                  first object is.
+//
+// ARGUMENTS:       object_size: The size of each object
+//                  slab_size: The number of objects in each slab, or 0
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_pool_init(ObjectPool *pool, size_t object_size,
+    size_t slab_size) {
+    if (0 == object_size) {
+        return (VoidResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_ARGUMENT};
+    }
+
+    // Every object must be able to hold a free list link, and must keep the
+    // objects after it aligned.
+    const size_t link = sizeof(void *);
+    pool->object_size = (object_size + link - 1) / link * link;
+    pool->slab_size = 0 == slab_size ? CS_POOL_DEFAULT_SLAB_SIZE : slab_size;
+    pool->free_list = NULL;
+    pool->unused = NULL;
+    pool->unused_end = NULL;
+    pool->slabs = NULL;
+
+    int error = pthread_mutex_init(&pool->lock, NULL);
+    if (0 != error) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | error};
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_alloc
+//
+// DESCRIPTION:     Allocate an object, reusing a released object if there is
+//                  one, and allocating a new slab only when the current one
+//                  is used up. The contents of the object are unspecified.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          PointerResult containing the object.
+////
+PointerResult cs_pool_alloc(ObjectPool *pool) {
+    void *object = pool->free_list;
+    if (NULL != object) {
+        pool->free_list = priv_pool_next(object);
+        return (PointerResult){.ok = true, .value = object};
+    }
+
+    if (pool->unused == pool->unused_end) {
+        VoidResult result = priv_pool_grow(pool);
+        if (!result.ok) {
+            return (PointerResult){.ok = false, .error = result.error};
+        }
+    }
+
+    object = pool->unused;
+    pool->unused += pool->object_size;
+    return (PointerResult){.ok = true, .value = object};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_release
+//
+// DESCRIPTION:     Return an object to the pool. The memory is not returned
+//                  to the system until the pool is freed.
+//
+// ARGUMENTS:       object: An object allocated from this pool
+//
+// RETURN:          none
+////
+void cs_pool_release(ObjectPool *pool, void *object) {
+    priv_pool_link(object, pool->free_list);
+    pool->free_list = object;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_free
+//
+// DESCRIPTION:     Free every slab in the pool. Any objects still in use are
+//                  invalidated, so this doubles as a bulk free.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_pool_free(ObjectPool *pool) {
+    PoolSlab *slab = pool->slabs;
+    while (NULL != slab) {
+        PoolSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->unused = NULL;
+    pool->unused_end = NULL;
+    pthread_mutex_destroy(&pool->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_cache_init
+//
+// DESCRIPTION:     Initialize an empty cache in front of the pool.
+//
+// ARGUMENTS:       pool: The pool to allocate from
+//                  capacity: The most objects to hold in the cache, or 0
+//
+// RETURN:          none
+////
+void cs_pool_cache_init(PoolCache *cache, ObjectPool *pool, size_t capacity) {
+    cache->pool = pool;
+    cache->free_list = NULL;
+    cache->size = 0;
+    cache->capacity = 0 == capacity ? CS_POOL_DEFAULT_CACHE_SIZE : capacity;
+    if (cache->capacity < 2) {
+        cache->capacity = 2;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_cache_alloc
+//
+// DESCRIPTION:     Allocate an object from the cache, refilling half of the
+//                  cache from the pool if it is empty.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          PointerResult containing the object.
+////
+PointerResult cs_pool_cache_alloc(PoolCache *cache) {
+    if (NULL == cache->free_list) {
+        ObjectPool *pool = cache->pool;
+        pthread_mutex_lock(&pool->lock);
+        while (cache->size < cache->capacity / 2) {
+            PointerResult result = cs_pool_alloc(pool);
+            if (!result.ok) {
+                if (0 == cache->size) {
+                    pthread_mutex_unlock(&pool->lock);
+                    return result;
+                }
+                break;
+            }
+            priv_pool_link(result.value, cache->free_list);
+            cache->free_list = result.value;
+            cache->size += 1;
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    void *object = cache->free_list;
+    cache->free_list = priv_pool_next(object);
+    cache->size -= 1;
+    return (PointerResult){.ok = true, .value = object};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_cache_release
+//
+// DESCRIPTION:     Return an object to the cache, returning half of the cache
+//                  to the pool if it is full.
+//
+// ARGUMENTS:       object: An object allocated from the cache's pool
+//
+// RETURN:          none
+////
+void cs_pool_cache_release(PoolCache *cache, void *object) {
+    priv_pool_link(object, cache->free_list);
+    cache->free_list = object;
+    cache->size += 1;
+    if (cache->size <= cache->capacity) {
+        return;
+    }
+
+    ObjectPool *pool = cache->pool;
+    pthread_mutex_lock(&pool->lock);
+    while (cache->size > cache->capacity / 2) {
+        void *next = priv_pool_next(cache->free_list);
+        cs_pool_release(pool, cache->free_list);
+        cache->free_list = next;
+        cache->size -= 1;
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_pool_cache_free
+//
+// DESCRIPTION:     Return every cached object to the pool. Must be called
+//                  before the owning thread exits, and before the pool is
+//                  freed.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_pool_cache_free(PoolCache *cache) {
+    ObjectPool *pool = cache->pool;
+    pthread_mutex_lock(&pool->lock);
+    while (NULL != cache->free_list) {
+        void *next = priv_pool_next(cache->free_list);
+        cs_pool_release(pool, cache->free_list);
+        cache->free_list = next;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    cache->size = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            pool.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Fixed-size object pool allocator
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_POOL_H
+#define SEASTAR_POOL_H
+
+#include <pthread.h>
+#include <stddef.h>
+
+#include <libseastar/result.h>
+
+static const size_t CS_POOL_DEFAULT_SLAB_SIZE = 64;
+static const size_t CS_POOL_DEFAULT_CACHE_SIZE = 32;
+
+// ObjectPool: Allocates objects of a single fixed size out of slabs of
+// slab_size objects each. Released objects are kept on an intrusive free list
+// and reused, so allocation and release are O(1), and objects allocated
+// together sit close together in memory. All slabs are freed at once when the
+// pool is freed. Objects are aligned to the largest power of two dividing the
+// rounded-up object size, up to the alignment of max_align_t.
+//
+// Like the other containers, cs_pool_alloc and cs_pool_release are not
+// synchronized. For multi-threaded use, give each thread a PoolCache, and
+// don't call cs_pool_alloc or cs_pool_release directly.
+typedef struct ObjectPool {
+    // NON USER CUSTOMIZABLE FIELDS
+    size_t object_size;
+    size_t slab_size;
+    void *free_list;
+    char *unused;
+    char *unused_end;
+    void *slabs;
+    pthread_mutex_t lock;
+} ObjectPool;
+
+// PoolCache: A per-thread cache in front of an ObjectPool. Allocation and
+// release only touch the cache, and the pool lock is taken once per batch of
+// capacity / 2 objects when the cache runs empty or overflows.
+typedef struct PoolCache {
+    // NON USER CUSTOMIZABLE FIELDS
+    ObjectPool *pool;
+    void *free_list;
+    size_t size;
+    size_t capacity;
+} PoolCache;
+
+// Initialize a pool of object_size objects. A slab_size of 0 selects the
+// default.
+VoidResult cs_pool_init(ObjectPool *pool, size_t object_size,
+    size_t slab_size);
+
+// Allocate an object from the pool
+PointerResult cs_pool_alloc(ObjectPool *pool);
+
+// Return an object to the pool
+void cs_pool_release(ObjectPool *pool, void *object);
+
+// Free every slab in the pool, including objects still in use
+void cs_pool_free(ObjectPool *pool);
+
+// Initialize a cache for the pool. A capacity of 0 selects the default.
+void cs_pool_cache_init(PoolCache *cache, ObjectPool *pool, size_t capacity);
+
+// Allocate an object through the cache
+PointerResult cs_pool_cache_alloc(PoolCache *cache);
+
+// Return an object through the cache
+void cs_pool_cache_release(PoolCache *cache, void *object);
+
+// Return all cached objects to the pool
+void cs_pool_cache_free(PoolCache *cache);
+
+#endif // SEASTAR_POOL_H
+
+///////////////////////////////////////////////////////////////////////////////
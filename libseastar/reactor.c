@@ -0,0 +1,598 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            reactor.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the epoll event loop
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+// For clock_gettime
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <libseastar/error.h>
+#include <libseastar/reactor.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// Timer states, stored in place of the heap index. A firing timer has been
+// removed from the heap, and is waiting in the expired vector to be called.
+#define CS_REACTOR_TIMER_IDLE SIZE_MAX
+#define CS_REACTOR_TIMER_FIRING (SIZE_MAX - 1)
+
+static void priv_reactor_update_time(Reactor *reactor) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    reactor->now = (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static void priv_reactor_notify(Reactor *reactor) {
+    uint64_t one = 1;
+    ssize_t written = write(reactor->wakeup, &one, sizeof(one));
+    // Only fails if the counter would overflow, in which case the loop is
+    // already due to wake up.
+    (void)written;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Timer heap
+////
+
+static inline ReactorTimer *priv_reactor_timer_at(Reactor *reactor,
+    size_t index) {
+    return reactor->timers.container[index];
+}
+
+static inline void priv_reactor_timer_place(Reactor *reactor, size_t index,
+    ReactorTimer *timer) {
+    reactor->timers.container[index] = timer;
+    timer->index = index;
+}
+
+static void priv_reactor_timer_sift_up(Reactor *reactor, size_t index) {
+    ReactorTimer *timer = priv_reactor_timer_at(reactor, index);
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        ReactorTimer *above = priv_reactor_timer_at(reactor, parent);
+        if (above->expiry <= timer->expiry) {
+            break;
+        }
+        priv_reactor_timer_place(reactor, index, above);
+        index = parent;
+    }
+    priv_reactor_timer_place(reactor, index, timer);
+}
+
+static void priv_reactor_timer_sift_down(Reactor *reactor, size_t index) {
+    size_t size = reactor->timers.size;
+    ReactorTimer *timer = priv_reactor_timer_at(reactor, index);
+    while (2 * index + 1 < size) {
+        size_t child = 2 * index + 1;
+        if (child + 1 < size
+            && priv_reactor_timer_at(reactor, child + 1)->expiry
+                < priv_reactor_timer_at(reactor, child)->expiry) {
+            child += 1;
+        }
+        ReactorTimer *below = priv_reactor_timer_at(reactor, child);
+        if (timer->expiry <= below->expiry) {
+            break;
+        }
+        priv_reactor_timer_place(reactor, index, below);
+        index = child;
+    }
+    priv_reactor_timer_place(reactor, index, timer);
+}
+
+// Remove a pending timer from the heap, or from the expired vector if it has
+// expired but not yet been called.
+static void priv_reactor_timer_remove(Reactor *reactor, ReactorTimer *timer) {
+    if (CS_REACTOR_TIMER_FIRING == timer->index) {
+        for (size_t i = reactor->expired_index; i < reactor->expired.size;
+             ++i) {
+            if (timer == reactor->expired.container[i]) {
+                reactor->expired.container[i] = NULL;
+            }
+        }
+    } else {
+        size_t index = timer->index;
+        ReactorTimer *last = reactor->timers.container[--reactor->timers.size];
+        if (last != timer) {
+            priv_reactor_timer_place(reactor, index, last);
+            priv_reactor_timer_sift_up(reactor, index);
+            priv_reactor_timer_sift_down(reactor, last->index);
+        }
+    }
+    timer->index = CS_REACTOR_TIMER_IDLE;
+}
+
+// Move every expired timer out of the heap, then call them. Timers started
+// by the callbacks wait for the next iteration, even if they are already due.
+static void priv_reactor_timer_expire(Reactor *reactor) {
+    reactor->expired.size = 0;
+    reactor->expired_index = 0;
+    while (reactor->timers.size > 0) {
+        ReactorTimer *timer = priv_reactor_timer_at(reactor, 0);
+        if (timer->expiry > reactor->now) {
+            break;
+        }
+
+        // If the expired vector can't grow, the rest fire next iteration
+        if (!cs_vector_push_back(&reactor->expired, timer).ok) {
+            break;
+        }
+        priv_reactor_timer_remove(reactor, timer);
+        timer->index = CS_REACTOR_TIMER_FIRING;
+    }
+
+    while (reactor->expired_index < reactor->expired.size) {
+        ReactorTimer *timer =
+            reactor->expired.container[reactor->expired_index++];
+        if (NULL != timer) {
+            timer->index = CS_REACTOR_TIMER_IDLE;
+            timer->callback(timer->context);
+        }
+    }
+    reactor->expired.size = 0;
+    reactor->expired_index = 0;
+}
+
+// The number of milliseconds until the next timer is due, or -1 if none are
+// pending
+static int priv_reactor_timer_timeout(Reactor *reactor) {
+    if (0 == reactor->timers.size) {
+        return -1;
+    }
+
+    uint64_t expiry = priv_reactor_timer_at(reactor, 0)->expiry;
+    if (expiry <= reactor->now) {
+        return 0;
+    }
+    uint64_t delay = expiry - reactor->now;
+    return delay > INT_MAX ? INT_MAX : (int)delay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Tasks
+////
+
+// Move tasks posted from other threads onto the deferred list
+static void priv_reactor_drain(Reactor *reactor) {
+    uint64_t count = 0;
+    ssize_t bytes = read(reactor->wakeup, &count, sizeof(count));
+    (void)bytes;
+
+    pthread_mutex_lock(&reactor->lock);
+    if (NULL != reactor->posted) {
+        *reactor->tasks_tail = reactor->posted;
+        reactor->tasks_tail = reactor->posted_tail;
+        reactor->posted = NULL;
+        reactor->posted_tail = &reactor->posted;
+    }
+    pthread_mutex_unlock(&reactor->lock);
+}
+
+// Run the tasks deferred so far. Tasks they defer run next iteration.
+static void priv_reactor_run_tasks(Reactor *reactor) {
+    ReactorTask *task = reactor->tasks;
+    reactor->tasks = NULL;
+    reactor->tasks_tail = &reactor->tasks;
+    while (NULL != task) {
+        ReactorTask *next = task->next;
+        task->callback(task->context);
+        task = next;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_init
+//
+// DESCRIPTION:     Create the epoll instance and the eventfd used to wake the
+//                  loop. The reactor must not be moved after this.
+//
+// ARGUMENTS:       batch: Maximum events per epoll_wait, or 0
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_reactor_init(Reactor *reactor, size_t batch) {
+    reactor->batch = 0 == batch ? CS_REACTOR_DEFAULT_BATCH : batch;
+    reactor->batch = reactor->batch > INT_MAX ? INT_MAX : reactor->batch;
+    reactor->dispatch_index = 0;
+    reactor->dispatch_count = 0;
+    reactor->expired_index = 0;
+    reactor->tasks = NULL;
+    reactor->tasks_tail = &reactor->tasks;
+    reactor->posted = NULL;
+    reactor->posted_tail = &reactor->posted;
+    atomic_init(&reactor->stopping, false);
+    priv_reactor_update_time(reactor);
+
+    reactor->epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (-1 == reactor->epoll) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    int error = 0;
+    struct epoll_event event = {.events = EPOLLIN};
+    event.data.ptr = &reactor->wakeup;
+    reactor->wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (-1 == reactor->wakeup) {
+        error = SEASTAR_ERRNO_SET | errno;
+    } else if (-1
+        == epoll_ctl(reactor->epoll, EPOLL_CTL_ADD, reactor->wakeup, &event)) {
+        error = SEASTAR_ERRNO_SET | errno;
+    }
+
+    reactor->events = malloc(reactor->batch * sizeof(struct epoll_event));
+    if (0 == error && NULL == reactor->events) {
+        error = SEASTAR_ERRNO_SET | errno;
+    }
+    VoidResult timers = cs_vector_init(&reactor->timers);
+    VoidResult expired = cs_vector_init(&reactor->expired);
+    if (0 == error && !(timers.ok && expired.ok)) {
+        error = SEASTAR_ERRNO_SET | ENOMEM;
+    }
+
+    if (0 != error) {
+        cs_vector_free(&reactor->expired);
+        cs_vector_free(&reactor->timers);
+        free(reactor->events);
+        if (-1 != reactor->wakeup) {
+            close(reactor->wakeup);
+        }
+        close(reactor->epoll);
+        return (VoidResult){.ok = false, .error = error};
+    }
+
+    pthread_mutex_init(&reactor->lock, NULL);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_add
+//
+// DESCRIPTION:     Register the file descriptor with the epoll instance.
+//
+// ARGUMENTS:       watch: Handle for the registration
+//                  fd: The file descriptor to watch
+//                  events: Epoll event mask to wait for
+//                  callback: Called with the ready events
+//                  context: Passed through to the callback
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_reactor_add(Reactor *reactor, ReactorWatch *watch, int fd,
+    uint32_t events, ReadyFn *callback, void *context) {
+    watch->fd = fd;
+    watch->callback = callback;
+    watch->context = context;
+    struct epoll_event event = {.events = events};
+    event.data.ptr = watch;
+    if (-1 == epoll_ctl(reactor->epoll, EPOLL_CTL_ADD, fd, &event)) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_modify
+//
+// DESCRIPTION:     Replace the event mask of a registered watch.
+//
+// ARGUMENTS:       watch: The registered watch
+//                  events: Epoll event mask to wait for
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_reactor_modify(Reactor *reactor, ReactorWatch *watch,
+    uint32_t events) {
+    struct epoll_event event = {.events = events};
+    event.data.ptr = watch;
+    if (-1 == epoll_ctl(reactor->epoll, EPOLL_CTL_MOD, watch->fd, &event)) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_remove
+//
+// DESCRIPTION:     Unregister the watch. Events for it that are later in the
+//                  batch being dispatched are dropped, so the watch may be
+//                  freed as soon as this returns.
+//
+// ARGUMENTS:       watch: The registered watch
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_reactor_remove(Reactor *reactor, ReactorWatch *watch) {
+    for (size_t i = reactor->dispatch_index + 1; i < reactor->dispatch_count;
+         ++i) {
+        if (watch == reactor->events[i].data.ptr) {
+            reactor->events[i].data.ptr = NULL;
+        }
+    }
+
+    if (-1 == epoll_ctl(reactor->epoll, EPOLL_CTL_DEL, watch->fd, NULL)) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_timer_init
+//
+// DESCRIPTION:     Initialize an idle timer.
+//
+// ARGUMENTS:       timer: The timer to initialize
+//                  callback: Called when the timer expires
+//                  context: Passed through to the callback
+//
+// RETURN:          none
+////
+void cs_reactor_timer_init(ReactorTimer *timer, ReactorFn *callback,
+    void *context) {
+    timer->expiry = 0;
+    timer->callback = callback;
+    timer->context = context;
+    timer->index = CS_REACTOR_TIMER_IDLE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_timer_start
+//
+// DESCRIPTION:     Insert the timer into the heap, to expire delay
+//                  milliseconds after the start of the current iteration.
+//
+// ARGUMENTS:       timer: An initialized timer
+//                  delay: Milliseconds until the timer expires
+//
+// RETURN:          VoidResult. If the heap cannot grow, the timer is left
+//                  idle.
+////
+VoidResult cs_reactor_timer_start(Reactor *reactor, ReactorTimer *timer,
+    uint64_t delay) {
+    if (CS_REACTOR_TIMER_IDLE != timer->index) {
+        priv_reactor_timer_remove(reactor, timer);
+    }
+
+    IndexResult result = cs_vector_push_back(&reactor->timers, timer);
+    if (!result.ok) {
+        return (VoidResult){.ok = false, .error = result.error};
+    }
+    timer->expiry = reactor->now + delay;
+    priv_reactor_timer_sift_up(reactor, result.value);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_timer_cancel
+//
+// DESCRIPTION:     Cancel a pending timer, including one that has expired in
+//                  this iteration but has not been called yet.
+//
+// ARGUMENTS:       timer: The timer to cancel
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_reactor_timer_cancel(Reactor *reactor, ReactorTimer *timer) {
+    if (CS_REACTOR_TIMER_IDLE == timer->index) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERROR_NOT_SCHEDULED};
+    }
+
+    priv_reactor_timer_remove(reactor, timer);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_defer
+//
+// DESCRIPTION:     Append the task to the deferred list. Tasks run in the
+//                  order they were deferred.
+//
+// ARGUMENTS:       task: Handle for the task
+//                  callback: Function to run
+//                  context: Passed through to the callback
+//
+// RETURN:          none
+////
+void cs_reactor_defer(Reactor *reactor, ReactorTask *task,
+    ReactorFn *callback, void *context) {
+    task->callback = callback;
+    task->context = context;
+    task->next = NULL;
+    *reactor->tasks_tail = task;
+    reactor->tasks_tail = &task->next;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_post
+//
+// DESCRIPTION:     Append the task to the list of posted tasks, which the
+//                  loop moves onto the deferred list when it is woken. Only
+//                  the post that makes the list non-empty writes to the
+//                  eventfd, so a burst of posts costs a single wakeup.
+//
+// ARGUMENTS:       task: Handle for the task
+//                  callback: Function to run on the loop thread
+//                  context: Passed through to the callback
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_reactor_post(Reactor *reactor, ReactorTask *task,
+    ReactorFn *callback, void *context) {
+    task->callback = callback;
+    task->context = context;
+    task->next = NULL;
+
+    pthread_mutex_lock(&reactor->lock);
+    bool notify = NULL == reactor->posted;
+    *reactor->posted_tail = task;
+    reactor->posted_tail = &task->next;
+    pthread_mutex_unlock(&reactor->lock);
+
+    if (notify) {
+        uint64_t one = 1;
+        if (-1 == write(reactor->wakeup, &one, sizeof(one))
+            && EAGAIN != errno) {
+            return (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | errno};
+        }
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_run_once
+//
+// DESCRIPTION:     Wait for events, and dispatch them, then fire expired
+//                  timers, and run deferred tasks. The wait is skipped if
+//                  tasks are already pending, and shortened so that it ends
+//                  when the next timer is due.
+//
+// ARGUMENTS:       timeout: Maximum milliseconds to wait, or -1
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_reactor_run_once(Reactor *reactor, int timeout) {
+    priv_reactor_update_time(reactor);
+    int due = priv_reactor_timer_timeout(reactor);
+    if (NULL != reactor->tasks) {
+        timeout = 0;
+    } else if (-1 != due && (timeout < 0 || due < timeout)) {
+        timeout = due;
+    }
+
+    int count = epoll_wait(
+        reactor->epoll, reactor->events, (int)reactor->batch, timeout);
+    if (-1 == count) {
+        if (EINTR != errno) {
+            return (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | errno};
+        }
+        count = 0;
+    }
+    priv_reactor_update_time(reactor);
+
+    reactor->dispatch_count = count;
+    for (reactor->dispatch_index = 0; reactor->dispatch_index < (size_t)count;
+         ++reactor->dispatch_index) {
+        struct epoll_event *event = &reactor->events[reactor->dispatch_index];
+        if (NULL == event->data.ptr) {
+            continue;
+        } else if (&reactor->wakeup == event->data.ptr) {
+            priv_reactor_drain(reactor);
+            continue;
+        }
+
+        ReactorWatch *watch = event->data.ptr;
+        watch->callback(watch->fd, event->events, watch->context);
+    }
+    reactor->dispatch_index = 0;
+    reactor->dispatch_count = 0;
+
+    priv_reactor_timer_expire(reactor);
+    priv_reactor_run_tasks(reactor);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_run
+//
+// DESCRIPTION:     Run iterations of the loop until it is stopped.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          VoidResult. Returns early if an iteration fails.
+////
+VoidResult cs_reactor_run(Reactor *reactor) {
+    VoidResult result = {.ok = true, 0};
+    while (result.ok && !atomic_load(&reactor->stopping)) {
+        result = cs_reactor_run_once(reactor, -1);
+    }
+    atomic_store(&reactor->stopping, false);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_stop
+//
+// DESCRIPTION:     Ask cs_reactor_run to return, waking the loop if it is
+//                  waiting.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_reactor_stop(Reactor *reactor) {
+    atomic_store(&reactor->stopping, true);
+    priv_reactor_notify(reactor);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_now
+//
+// DESCRIPTION:     Get the cached time of the current iteration.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          Milliseconds of CLOCK_MONOTONIC
+////
+uint64_t cs_reactor_now(Reactor *reactor) {
+    return reactor->now;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_reactor_free
+//
+// DESCRIPTION:     Release the reactor's descriptors and memory.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_reactor_free(Reactor *reactor) {
+    close(reactor->wakeup);
+    close(reactor->epoll);
+    free(reactor->events);
+    cs_vector_free(&reactor->timers);
+    cs_vector_free(&reactor->expired);
+    pthread_mutex_destroy(&reactor->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            reactor.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Single-threaded epoll event loop
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_REACTOR_H
+#define SEASTAR_REACTOR_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#include <libseastar/result.h>
+#include <libseastar/vector.h>
+
+static const size_t CS_REACTOR_DEFAULT_BATCH = 64;
+
+// Called when a watched file descriptor is ready. events is the epoll event
+// mask (EPOLLIN, EPOLLOUT, EPOLLERR, ...).
+typedef void ReadyFn(int fd, uint32_t events, void *context);
+
+// Called when a timer expires, or a task is run
+typedef void ReactorFn(void *context);
+
+// A file descriptor registered with the reactor. Like the reactor's other
+// handles, it is allocated by the user, and must not be freed while it is
+// registered.
+typedef struct ReactorWatch {
+    // NON USER CUSTOMIZABLE FIELDS
+    int fd;
+    ReadyFn *callback;
+    void *context;
+} ReactorWatch;
+
+// A one-shot timer. Must be initialized with cs_reactor_timer_init before it
+// is first started, and must not be freed while it is pending.
+typedef struct ReactorTimer {
+    // NON USER CUSTOMIZABLE FIELDS
+    uint64_t expiry;
+    ReactorFn *callback;
+    void *context;
+    // Position in the timer heap, or one of the states in reactor.c
+    size_t index;
+} ReactorTimer;
+
+// A deferred task. Must not be freed until it has run.
+typedef struct ReactorTask {
+    // NON USER CUSTOMIZABLE FIELDS
+    ReactorFn *callback;
+    void *context;
+    struct ReactorTask *next;
+} ReactorTask;
+
+// Reactor: Single-threaded event loop. Each iteration waits in epoll_wait for
+// up to batch ready descriptors (or until the next timer is due), calls the
+// ready callbacks, fires expired timers, and then runs the tasks that were
+// deferred before the iteration began. Timers are kept in a binary min-heap,
+// so starting and cancelling a timer are O(log n). Times are milliseconds of
+// CLOCK_MONOTONIC, read once per iteration, so timers have millisecond
+// resolution.
+//
+// Apart from cs_reactor_post and cs_reactor_stop, which may be called from
+// any thread and wake the loop through an eventfd, every function must be
+// called from the thread running the loop (or before it is started).
+// Callbacks may freely add and remove watches, start and cancel timers, and
+// defer tasks, including their own.
+typedef struct Reactor {
+    // NON USER CUSTOMIZABLE FIELDS
+    int epoll;
+    int wakeup;
+    uint64_t now;
+    size_t batch;
+    struct epoll_event *events;
+    size_t dispatch_index;
+    size_t dispatch_count;
+
+    Vector timers;
+    Vector expired;
+    size_t expired_index;
+
+    ReactorTask *tasks;
+    ReactorTask **tasks_tail;
+
+    pthread_mutex_t lock;
+    ReactorTask *posted;
+    ReactorTask **posted_tail;
+    atomic_bool stopping;
+} Reactor;
+
+// Initialize a reactor that handles up to batch events per epoll_wait. A
+// batch of 0 selects the default.
+VoidResult cs_reactor_init(Reactor *reactor, size_t batch);
+
+// Watch fd for the events in the epoll mask. Level-triggered unless
+// EPOLLET is included.
+VoidResult cs_reactor_add(Reactor *reactor, ReactorWatch *watch, int fd,
+    uint32_t events, ReadyFn *callback, void *context);
+
+// Change the events a watch waits for
+VoidResult cs_reactor_modify(Reactor *reactor, ReactorWatch *watch,
+    uint32_t events);
+
+// Stop watching. Pending events for the watch are discarded, even if they
+// were returned in the batch currently being dispatched.
+VoidResult cs_reactor_remove(Reactor *reactor, ReactorWatch *watch);
+
+// Initialize a timer with its callback
+void cs_reactor_timer_init(ReactorTimer *timer, ReactorFn *callback,
+    void *context);
+
+// Start the timer to expire delay milliseconds from now. Pending timers are
+// restarted.
+VoidResult cs_reactor_timer_start(Reactor *reactor, ReactorTimer *timer,
+    uint64_t delay);
+
+// Cancel the timer. Returns SEASTAR_ERROR_NOT_SCHEDULED if it is not pending.
+VoidResult cs_reactor_timer_cancel(Reactor *reactor, ReactorTimer *timer);
+
+// Run the callback at the end of the next iteration of the loop
+void cs_reactor_defer(Reactor *reactor, ReactorTask *task,
+    ReactorFn *callback, void *context);
+
+// Defer a task from any thread, waking the loop
+VoidResult cs_reactor_post(Reactor *reactor, ReactorTask *task,
+    ReactorFn *callback, void *context);
+
+// Run a single iteration of the loop, waiting at most timeout milliseconds
+// for events (-1 waits until an event or timer is due)
+VoidResult cs_reactor_run_once(Reactor *reactor, int timeout);
+
+// Run the loop until cs_reactor_stop is called
+VoidResult cs_reactor_run(Reactor *reactor);
+
+// Make cs_reactor_run return after the current iteration. Safe from any
+// thread.
+void cs_reactor_stop(Reactor *reactor);
+
+// The time at the start of the current iteration
+uint64_t cs_reactor_now(Reactor *reactor);
+
+// Close the epoll and eventfd descriptors, and free internal memory. Watches
+// and pending timers and tasks are abandoned.
+void cs_reactor_free(Reactor *reactor);
+
+#endif // SEASTAR_REACTOR_H
+
+///////////////////////////////////////////////////////////////////////////////
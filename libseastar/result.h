@@ -8,7 +8,7 @@
 //
 // CREATED:         11/13/2021
 //
-// LAST EDITED:     11/13/2021
+// LAST EDITED:     10/19/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -61,6 +61,15 @@ typedef struct IndexResult {
     };
 } IndexResult;
 
+// Result type containing a boolean
+typedef struct BoolResult {
+    bool ok;
+    union {
+        bool value;
+        int error;
+    };
+} BoolResult;
+
 #endif // SEASTAR_RESULT_H
 
 ///////////////////////////////////////////////////////////////////////////////
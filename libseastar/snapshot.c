@@ -0,0 +1,331 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            snapshot.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the copy-on-write snapshot vector
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libseastar/error.h>
+#include <libseastar/snapshot.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// A reader announcing this epoch is not in a read-side critical section
+#define CS_SNAPSHOT_IDLE 0
+
+typedef struct SnapshotVersion {
+    Vector vector;
+    // The epoch in which this version was replaced. Readers that entered in a
+    // later epoch cannot hold it.
+    uint64_t retired;
+    struct SnapshotVersion *next;
+} SnapshotVersion;
+
+static void priv_snapshot_version_free(SnapshotVersion *version) {
+    cs_vector_free(&version->vector);
+    free(version);
+}
+
+// Copy a vector into a new version, preserving its capacity so that the
+// writer can append to the copy without reallocating right away.
+static SnapshotVersion *priv_snapshot_copy(Vector *vector) {
+    SnapshotVersion *version = malloc(sizeof(SnapshotVersion));
+    if (NULL == version) {
+        return NULL;
+    }
+
+    version->vector = *vector;
+    version->vector.container = malloc(vector->capacity * sizeof(void *));
+    if (NULL == version->vector.container) {
+        free(version);
+        return NULL;
+    }
+    memcpy(version->vector.container, vector->container,
+        vector->size * sizeof(void *));
+    version->retired = 0;
+    version->next = NULL;
+    return version;
+}
+
+// Free every retired version that was replaced before the oldest epoch
+// announced by a reader. Caller holds the lock.
+static void priv_snapshot_reclaim(SnapshotVector *snapshot) {
+    uint64_t oldest = UINT64_MAX;
+    for (SnapshotReader *reader = snapshot->readers; NULL != reader;
+         reader = reader->next) {
+        uint64_t epoch = atomic_load(&reader->epoch);
+        if (CS_SNAPSHOT_IDLE != epoch && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    SnapshotVersion **link = &snapshot->retired;
+    while (NULL != *link) {
+        SnapshotVersion *version = *link;
+        if (version->retired < oldest) {
+            *link = version->next;
+            priv_snapshot_version_free(version);
+        } else {
+            link = &version->next;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_init
+//
+// DESCRIPTION:     Initialize the snapshot vector with an empty version.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_snapshot_init(SnapshotVector *snapshot) {
+    SnapshotVersion *version = malloc(sizeof(SnapshotVersion));
+    if (NULL == version) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    VoidResult result = cs_vector_init(&version->vector);
+    if (!result.ok) {
+        free(version);
+        return result;
+    }
+    version->retired = 0;
+    version->next = NULL;
+
+    // Epoch 0 is reserved for idle readers
+    atomic_init(&snapshot->epoch, 1);
+    atomic_init(&snapshot->current, version);
+    pthread_mutex_init(&snapshot->lock, NULL);
+    snapshot->draft = NULL;
+    snapshot->retired = NULL;
+    snapshot->readers = NULL;
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_register
+//
+// DESCRIPTION:     Add a reader record. Each thread that reads from the
+//                  snapshot vector needs its own.
+//
+// ARGUMENTS:       reader: The record to add
+//
+// RETURN:          none
+////
+void cs_snapshot_register(SnapshotVector *snapshot, SnapshotReader *reader) {
+    atomic_init(&reader->epoch, CS_SNAPSHOT_IDLE);
+    pthread_mutex_lock(&snapshot->lock);
+    reader->next = snapshot->readers;
+    reader->pprev = &snapshot->readers;
+    if (NULL != snapshot->readers) {
+        snapshot->readers->pprev = &reader->next;
+    }
+    snapshot->readers = reader;
+    pthread_mutex_unlock(&snapshot->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_unregister
+//
+// DESCRIPTION:     Remove a reader record. The reader must not be in a
+//                  read-side critical section.
+//
+// ARGUMENTS:       reader: The record to remove
+//
+// RETURN:          none
+////
+void cs_snapshot_unregister(SnapshotVector *snapshot, SnapshotReader *reader) {
+    pthread_mutex_lock(&snapshot->lock);
+    *reader->pprev = reader->next;
+    if (NULL != reader->next) {
+        reader->next->pprev = reader->pprev;
+    }
+    reader->next = NULL;
+    reader->pprev = NULL;
+    pthread_mutex_unlock(&snapshot->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_read_begin
+//
+// DESCRIPTION:     Announce the current epoch, then load the current version.
+//                  Both are sequentially consistent: a writer that replaces a
+//                  version and then advances the epoch either sees this
+//                  announcement, or this load sees the replacement.
+//
+// ARGUMENTS:       reader: This thread's registered reader record
+//
+// RETURN:          The current version, which must not be modified.
+////
+Vector *cs_snapshot_read_begin(SnapshotVector *snapshot,
+    SnapshotReader *reader) {
+    atomic_store(&reader->epoch, atomic_load(&snapshot->epoch));
+    return &atomic_load(&snapshot->current)->vector;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_read_end
+//
+// DESCRIPTION:     Leave the read-side critical section. The version returned
+//                  by cs_snapshot_read_begin may be reclaimed afterwards.
+//
+// ARGUMENTS:       reader: This thread's registered reader record
+//
+// RETURN:          none
+////
+void cs_snapshot_read_end(SnapshotReader *reader) {
+    atomic_store_explicit(&reader->epoch, CS_SNAPSHOT_IDLE,
+        memory_order_release);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_write_begin
+//
+// DESCRIPTION:     Take the writer lock, and copy the current version. The
+//                  copy may be modified with the usual Vector functions.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          PointerResult containing the Vector* to modify. On error,
+//                  the lock is not held.
+////
+PointerResult cs_snapshot_write_begin(SnapshotVector *snapshot) {
+    pthread_mutex_lock(&snapshot->lock);
+    SnapshotVersion *current =
+        atomic_load_explicit(&snapshot->current, memory_order_relaxed);
+    snapshot->draft = priv_snapshot_copy(&current->vector);
+    if (NULL == snapshot->draft) {
+        int error = errno;
+        pthread_mutex_unlock(&snapshot->lock);
+        return (PointerResult){
+            .ok = false, .error = SEASTAR_ERRNO_SET | error};
+    }
+    return (PointerResult){.ok = true, .value = &snapshot->draft->vector};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_publish
+//
+// DESCRIPTION:     Make the copy returned by cs_snapshot_write_begin the
+//                  current version, retire the version it replaced, and
+//                  release the writer lock.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_snapshot_publish(SnapshotVector *snapshot) {
+    SnapshotVersion *old = atomic_exchange(&snapshot->current, snapshot->draft);
+    snapshot->draft = NULL;
+    old->retired = atomic_fetch_add(&snapshot->epoch, 1);
+    old->next = snapshot->retired;
+    snapshot->retired = old;
+    priv_snapshot_reclaim(snapshot);
+    pthread_mutex_unlock(&snapshot->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_abort
+//
+// DESCRIPTION:     Free the copy returned by cs_snapshot_write_begin, and
+//                  release the writer lock.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_snapshot_abort(SnapshotVector *snapshot) {
+    priv_snapshot_version_free(snapshot->draft);
+    snapshot->draft = NULL;
+    pthread_mutex_unlock(&snapshot->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_synchronize
+//
+// DESCRIPTION:     Wait for a grace period: every retired version was
+//                  replaced before the current epoch, so once each reader is
+//                  idle or has announced the current epoch, none of them can
+//                  be held. Writers are blocked while this waits.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_snapshot_synchronize(SnapshotVector *snapshot) {
+    pthread_mutex_lock(&snapshot->lock);
+    uint64_t epoch = atomic_load(&snapshot->epoch);
+    for (SnapshotReader *reader = snapshot->readers; NULL != reader;
+         reader = reader->next) {
+        while (true) {
+            uint64_t announced = atomic_load(&reader->epoch);
+            if (CS_SNAPSHOT_IDLE == announced || announced >= epoch) {
+                break;
+            }
+            sched_yield();
+        }
+    }
+
+    priv_snapshot_reclaim(snapshot);
+    pthread_mutex_unlock(&snapshot->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_snapshot_free
+//
+// DESCRIPTION:     Free the current version and every retired version.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_snapshot_free(SnapshotVector *snapshot) {
+    priv_snapshot_version_free(atomic_load(&snapshot->current));
+    while (NULL != snapshot->retired) {
+        SnapshotVersion *version = snapshot->retired;
+        snapshot->retired = version->next;
+        priv_snapshot_version_free(version);
+    }
+    snapshot->readers = NULL;
+    pthread_mutex_destroy(&snapshot->lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            snapshot.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Copy-on-write Vector snapshots for lock-free readers
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_SNAPSHOT_H
+#define SEASTAR_SNAPSHOT_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include <libseastar/result.h>
+#include <libseastar/vector.h>
+
+struct SnapshotVersion;
+
+// SnapshotReader: Per-thread reader record. Each reader thread registers one
+// with the SnapshotVector, and announces the epoch it entered in while it
+// holds a snapshot. Padded to a cache line, so that readers entering and
+// leaving do not contend with each other.
+typedef struct SnapshotReader {
+    // NON USER CUSTOMIZABLE FIELDS
+    _Alignas(64) _Atomic uint64_t epoch;
+    struct SnapshotReader *next;
+    struct SnapshotReader **pprev;
+} SnapshotReader;
+
+// SnapshotVector: A Vector of pointers that is never modified in place.
+// Readers load the current version with a single atomic load, and may scan
+// it without locks for as long as they hold it. A writer edits a private copy
+// and publishes it atomically. Versions replaced while a reader may still
+// hold them are retired, and reclaimed once every reader that entered before
+// the replacement has left (epoch-based reclamation).
+//
+// Like Vector, the container does not own its elements. Writers are
+// serialized with a mutex, and never wait for readers.
+typedef struct SnapshotVector {
+    // NON USER CUSTOMIZABLE FIELDS
+    _Alignas(64) _Atomic uint64_t epoch;
+    _Alignas(64) _Atomic(struct SnapshotVersion *) current;
+    pthread_mutex_t lock;
+    struct SnapshotVersion *draft;
+    struct SnapshotVersion *retired;
+    SnapshotReader *readers;
+} SnapshotVector;
+
+// Initialize an empty snapshot vector
+VoidResult cs_snapshot_init(SnapshotVector *snapshot);
+
+// Add or remove a reader record. The record must not hold a snapshot.
+void cs_snapshot_register(SnapshotVector *snapshot, SnapshotReader *reader);
+void cs_snapshot_unregister(SnapshotVector *snapshot, SnapshotReader *reader);
+
+// Enter a read-side critical section, returning the current version. It must
+// not be modified, and stays valid until cs_snapshot_read_end.
+Vector *cs_snapshot_read_begin(SnapshotVector *snapshot,
+    SnapshotReader *reader);
+void cs_snapshot_read_end(SnapshotReader *reader);
+
+// Begin an update, returning a private copy of the current version to modify.
+// Must be followed by cs_snapshot_publish or cs_snapshot_abort.
+PointerResult cs_snapshot_write_begin(SnapshotVector *snapshot);
+
+// Atomically replace the current version with the copy, and reclaim retired
+// versions that no reader can still hold.
+void cs_snapshot_publish(SnapshotVector *snapshot);
+
+// Discard the copy, leaving the current version unchanged
+void cs_snapshot_abort(SnapshotVector *snapshot);
+
+// Wait until every reader that may hold a replaced version has left, and
+// reclaim all retired versions. Afterwards, elements removed by earlier
+// updates are no longer reachable by readers and may be freed.
+void cs_snapshot_synchronize(SnapshotVector *snapshot);
+
+// Free internally allocated memory. No reader may hold a snapshot.
+void cs_snapshot_free(SnapshotVector *snapshot);
+
+#endif // SEASTAR_SNAPSHOT_H
+
+///////////////////////////////////////////////////////////////////////////////
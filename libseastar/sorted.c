@@ -0,0 +1,416 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            sorted.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the sorted vector
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <libseastar/error.h>
+#include <libseastar/sorted.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// A node of the Eytzinger layout. Four nodes fill a 64-byte cache line.
+typedef struct SortedNode {
+    void *value;
+    size_t index;
+} SortedNode;
+
+static const size_t CS_SORTED_CACHE_LINE = 64;
+
+// Discard the Eytzinger layout, if any
+static void priv_sorted_thaw(SortedVector *sorted) {
+    if (NULL != sorted->layout) {
+        free(sorted->layout);
+        sorted->layout = NULL;
+    }
+}
+
+// Fill the layout by an in-order walk of the implicit tree rooted at node
+static size_t priv_sorted_fill(SortedVector *sorted, size_t node,
+    size_t index) {
+    if (node > sorted->container.size) {
+        return index;
+    }
+
+    index = priv_sorted_fill(sorted, 2 * node, index);
+    sorted->layout[node].value = sorted->container.container[index];
+    sorted->layout[node].index = index;
+    return priv_sorted_fill(sorted, 2 * node + 1, index + 1);
+}
+
+// Search for the first element for which comparator(element, key) >= limit.
+// A limit of 0 yields the lower bound, and 1 the upper bound.
+static size_t priv_sorted_search(SortedVector *sorted, void *key, int limit) {
+    size_t size = sorted->container.size;
+    if (NULL != sorted->layout) {
+        // The node four times as far along is the first grandchild, so each
+        // step prefetches the cache line holding all four grandchildren. The
+        // children's line was prefetched by the step before, so the elements
+        // they point to can be prefetched too.
+        const SortedNode *layout = sorted->layout;
+        size_t node = 1;
+        while (node <= size) {
+            __builtin_prefetch(&layout[4 * node]);
+            if (2 * node + 1 <= size) {
+                __builtin_prefetch(layout[2 * node].value);
+                __builtin_prefetch(layout[2 * node + 1].value);
+            }
+            void *value = layout[node].value;
+            node = 2 * node + (sorted->comparator(&value, &key) < limit);
+        }
+
+        // Undo the right turns taken after the last left turn
+        node >>= __builtin_ffsll(~node);
+        return 0 == node ? size : layout[node].index;
+    }
+
+    void **container = sorted->container.container;
+    size_t low = 0;
+    size_t high = size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (sorted->comparator(&container[middle], &key) < limit) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        private_range_next
+//
+// DESCRIPTION:     Return the next element in the range.
+//
+// ARGUMENTS:       private: The SortedRange*
+//                  state: The index of the iterator
+//
+// RETURN:          The next element, or NULL.
+////
+static void *private_range_next(void *private, union IteratorState *state) {
+    SortedRange *range = (SortedRange *)private;
+    if (state->size < range->end) {
+        return range->sorted->container.container[state->size++];
+    }
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_init
+//
+// DESCRIPTION:     Initialize an empty sorted vector
+//
+// ARGUMENTS:       comparator: The comparison function to sort elements by
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_sorted_init(SortedVector *sorted, ComparisonFn *comparator) {
+    sorted->comparator = comparator;
+    sorted->layout = NULL;
+    return cs_vector_init(&sorted->container);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_build
+//
+// DESCRIPTION:     Replace the contents of the sorted vector with the
+//                  elements of another vector, sorting them once.
+//
+// ARGUMENTS:       elements: The elements, in any order
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_sorted_build(SortedVector *sorted, Vector *elements) {
+    priv_sorted_thaw(sorted);
+    sorted->container.size = 0;
+    for (size_t i = 0; i < elements->size; ++i) {
+        IndexResult result =
+            cs_vector_push_back(&sorted->container, elements->container[i]);
+        if (!result.ok) {
+            return (VoidResult){.ok = false, .error = result.error};
+        }
+    }
+
+    qsort((void *)sorted->container.container, sorted->container.size,
+        sizeof(void *), sorted->comparator);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_insert
+//
+// DESCRIPTION:     Insert an element after any elements equal to it. This is
+//                  O(n); prefer cs_sorted_merge for batches.
+//
+// ARGUMENTS:       user_data: The element to insert
+//
+// RETURN:          IndexResult containing the index of the new element.
+////
+IndexResult cs_sorted_insert(SortedVector *sorted, void *user_data) {
+    priv_sorted_thaw(sorted);
+    size_t index = priv_sorted_search(sorted, user_data, 1);
+    IndexResult result = cs_vector_push_back(&sorted->container, user_data);
+    if (!result.ok) {
+        return result;
+    }
+
+    void **container = sorted->container.container;
+    for (size_t i = sorted->container.size - 1; i > index; --i) {
+        container[i] = container[i - 1];
+    }
+    container[index] = user_data;
+    return (IndexResult){.ok = true, .value = index};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_merge
+//
+// DESCRIPTION:     Merge a sorted batch of elements into the vector in
+//                  O(n + m). Batch elements are placed after existing
+//                  elements that compare equal to them.
+//
+// ARGUMENTS:       batch: Elements sorted by the same comparator
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_sorted_merge(SortedVector *sorted, Vector *batch) {
+    priv_sorted_thaw(sorted);
+    size_t old_size = sorted->container.size;
+    for (size_t i = 0; i < batch->size; ++i) {
+        IndexResult result =
+            cs_vector_push_back(&sorted->container, batch->container[i]);
+        if (!result.ok) {
+            sorted->container.size = old_size;
+            return (VoidResult){.ok = false, .error = result.error};
+        }
+    }
+
+    // Merge from the back, so that no element is overwritten before it moves
+    void **container = sorted->container.container;
+    size_t left = old_size;
+    size_t right = batch->size;
+    size_t out = sorted->container.size;
+    while (right > 0) {
+        if (left > 0
+            && sorted->comparator(&container[left - 1],
+                   &batch->container[right - 1])
+                > 0) {
+            container[--out] = container[--left];
+        } else {
+            container[--out] = batch->container[--right];
+        }
+    }
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_get
+//
+// DESCRIPTION:     Return the element at index.
+//
+// ARGUMENTS:       index: index of the element to get
+//
+// RETURN:          PointerResult, with value set to the element if ok.
+////
+PointerResult cs_sorted_get(SortedVector *sorted, size_t index) {
+    return cs_vector_get(&sorted->container, index);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_remove
+//
+// DESCRIPTION:     Remove the element at index.
+//
+// ARGUMENTS:       index: index of the element to remove
+//
+// RETURN:          PointerResult containing the removed element.
+////
+PointerResult cs_sorted_remove(SortedVector *sorted, size_t index) {
+    priv_sorted_thaw(sorted);
+    return cs_vector_remove(&sorted->container, index);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_lower_bound
+//
+// DESCRIPTION:     Find the first element that does not compare less than
+//                  key.
+//
+// ARGUMENTS:       key: The key to search for
+//
+// RETURN:          IndexResult containing the index, which is the size of the
+//                  vector if every element is less than key.
+////
+IndexResult cs_sorted_lower_bound(SortedVector *sorted, void *key) {
+    return (IndexResult){
+        .ok = true, .value = priv_sorted_search(sorted, key, 0)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_upper_bound
+//
+// DESCRIPTION:     Find the first element that compares greater than key.
+//
+// ARGUMENTS:       key: The key to search for
+//
+// RETURN:          IndexResult containing the index, which is the size of the
+//                  vector if no element is greater than key.
+////
+IndexResult cs_sorted_upper_bound(SortedVector *sorted, void *key) {
+    return (IndexResult){
+        .ok = true, .value = priv_sorted_search(sorted, key, 1)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_find
+//
+// DESCRIPTION:     Find the first element that compares equal to key.
+//
+// ARGUMENTS:       key: The key to search for
+//
+// RETURN:          PointerResult containing the element, or
+//                  SEASTAR_ERROR_INVALID_INDEX if there is none.
+////
+PointerResult cs_sorted_find(SortedVector *sorted, void *key) {
+    size_t index = priv_sorted_search(sorted, key, 0);
+    if (index < sorted->container.size
+        && 0 == sorted->comparator(&sorted->container.container[index], &key)) {
+        return (PointerResult){
+            .ok = true, .value = sorted->container.container[index]};
+    }
+
+    return (PointerResult){.ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_range
+//
+// DESCRIPTION:     Find the range of elements that compare between low and
+//                  high, inclusive.
+//
+// ARGUMENTS:       low: The lowest key in the range
+//                  high: The highest key in the range
+//
+// RETURN:          SortedRange, which is empty if high < low.
+////
+SortedRange cs_sorted_range(SortedVector *sorted, void *low, void *high) {
+    SortedRange range = {0};
+    range.sorted = sorted;
+    range.begin = priv_sorted_search(sorted, low, 0);
+    range.end = priv_sorted_search(sorted, high, 1);
+    if (range.end < range.begin) {
+        range.end = range.begin;
+    }
+    return range;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_freeze
+//
+// DESCRIPTION:     Build the Eytzinger search layout, which is used by every
+//                  search until the vector is next modified.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_sorted_freeze(SortedVector *sorted) {
+    priv_sorted_thaw(sorted);
+
+    // Node 0 is unused, and the search prefetches up to 4 * (size + 1) nodes
+    // in. Prefetches are harmless past the end, but keep the array aligned to
+    // a cache line so that each group of four grandchildren shares one line.
+    size_t bytes = (sorted->container.size + 1) * sizeof(SortedNode);
+    bytes = (bytes + CS_SORTED_CACHE_LINE - 1) / CS_SORTED_CACHE_LINE
+        * CS_SORTED_CACHE_LINE;
+    sorted->layout = aligned_alloc(CS_SORTED_CACHE_LINE, bytes);
+    if (NULL == sorted->layout) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    priv_sorted_fill(sorted, 1, 0);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_free
+//
+// DESCRIPTION:     Free internally allocated memory for the sorted vector.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_sorted_free(SortedVector *sorted) {
+    priv_sorted_thaw(sorted);
+    cs_vector_free(&sorted->container);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_iter
+//
+// DESCRIPTION:     Create an iterator over every element, in order.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          Iterator
+////
+Iterator cs_sorted_iter(SortedVector *sorted) {
+    return cs_vector_iter(&sorted->container);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_sorted_range_iter
+//
+// DESCRIPTION:     Create an iterator over the elements in a range, in order.
+//                  The range must outlive the iterator.
+//
+// ARGUMENTS:       range: The range to iterate over
+//
+// RETURN:          Iterator
+////
+Iterator cs_sorted_range_iter(SortedRange *range) {
+    Iterator iter = {0};
+    iter.next = private_range_next;
+    iter.private = range;
+    iter.state.size = range->begin;
+    return iter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            sorted.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Sorted flat vector with an optional cache-friendly search
+//                  layout
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_SORTED_H
+#define SEASTAR_SORTED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <libseastar/iterator.h>
+#include <libseastar/pqueue.h>
+#include <libseastar/result.h>
+#include <libseastar/vector.h>
+
+struct SortedNode;
+
+// SortedVector: Non-owning vector kept sorted by comparator, searched by
+// binary search. Read-mostly tables can be frozen with cs_sorted_freeze, which
+// builds a copy of the elements in Eytzinger (breadth-first) order. Searches
+// on a frozen vector touch far fewer cache lines, and prefetch two levels
+// ahead. Any modification thaws the vector again. Keys passed to the search
+// functions are compared with the comparator exactly like elements.
+typedef struct SortedVector {
+    // NON USER CUSTOMIZABLE FIELDS
+    ComparisonFn *comparator;
+    Vector container;
+    struct SortedNode *layout;
+} SortedVector;
+
+// A half-open range [begin, end) of indices into a SortedVector
+typedef struct SortedRange {
+    SortedVector *sorted;
+    size_t begin;
+    size_t end;
+} SortedRange;
+
+// Initialize an empty sorted vector
+VoidResult cs_sorted_init(SortedVector *sorted, ComparisonFn *comparator);
+
+// Replace the contents with the (unsorted) elements of a vector
+VoidResult cs_sorted_build(SortedVector *sorted, Vector *elements);
+
+// Insert an element, returning its index
+IndexResult cs_sorted_insert(SortedVector *sorted, void *user_data);
+
+// Merge a batch of elements, which must already be sorted by comparator
+VoidResult cs_sorted_merge(SortedVector *sorted, Vector *batch);
+
+// Get/remove the element at index
+PointerResult cs_sorted_get(SortedVector *sorted, size_t index);
+PointerResult cs_sorted_remove(SortedVector *sorted, size_t index);
+
+// Index of the first element not less than/greater than key
+IndexResult cs_sorted_lower_bound(SortedVector *sorted, void *key);
+IndexResult cs_sorted_upper_bound(SortedVector *sorted, void *key);
+
+// Find an element equal to key
+PointerResult cs_sorted_find(SortedVector *sorted, void *key);
+
+// The range of elements between low and high, inclusive
+SortedRange cs_sorted_range(SortedVector *sorted, void *low, void *high);
+
+// Build the Eytzinger search layout
+VoidResult cs_sorted_freeze(SortedVector *sorted);
+
+// Free internally allocated memory
+void cs_sorted_free(SortedVector *sorted);
+
+// Iterators over all elements, and over a range of elements
+Iterator cs_sorted_iter(SortedVector *sorted);
+Iterator cs_sorted_range_iter(SortedRange *range);
+
+#endif // SEASTAR_SORTED_H
+
+///////////////////////////////////////////////////////////////////////////////
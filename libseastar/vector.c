@@ -7,7 +7,7 @@
 //
 // CREATED:         11/13/2021
 //
-// LAST EDITED:     11/13/2021
+// LAST EDITED:     10/19/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -49,10 +49,11 @@ static IndexResult priv_vector_resize(Vector *vector) {
     // 1. Realloc fails--old memory block is untouched
     if (NULL == new_container) {
         return (IndexResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
-    } else if (new_container != vector->container) {
-        vector->container = new_container;
     }
 
+    vector->container = new_container;
+    vector->capacity = new_size;
+
     return (IndexResult){.ok = true, .value = vector->size};
 }
 
@@ -74,6 +75,30 @@ static void *private_iter_next(void *private, union IteratorState *state) {
     return NULL;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        private_iter_next_prefetch
+//
+// DESCRIPTION:     Return the next element in the iterator, prefetching the
+//                  element vector->prefetch places ahead of it.
+//
+// ARGUMENTS:       private: The Vector*
+//                  state: The index of the iterator
+//
+// RETURN:          The next element, or NULL.
+////
+static void *private_iter_next_prefetch(void *private,
+    union IteratorState *state) {
+    Vector *vector = (Vector *)private;
+    if (state->size < vector->size) {
+        size_t ahead = state->size + vector->prefetch;
+        if (ahead < vector->size) {
+            __builtin_prefetch(vector->container[ahead]);
+        }
+        return vector->container[state->size++];
+    }
+    return NULL;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Public Interface
 ////
@@ -92,13 +117,16 @@ size_t cs_vector_default_expansion_function(size_t n) { return 2 * n; }
 ///////////////////////////////////////////////////////////////////////////////
 // FUNCTION:        cs_vector_init
 //
-// DESCRIPTION:     Initialize the vector with the default size
+// DESCRIPTION:     Initialize the vector with the default size and expansion
+//                  function
 //
 // ARGUMENTS:       none
 //
 // RETURN:          none
 ////
 VoidResult cs_vector_init(Vector *vector) {
+    vector->expander = cs_vector_default_expansion_function;
+    vector->prefetch = 0;
     vector->size = 0;
     vector->capacity = CS_VECTOR_DEFAULT_SIZE;
     vector->container = calloc(vector->capacity, sizeof(void *));
@@ -119,12 +147,7 @@ VoidResult cs_vector_init(Vector *vector) {
 // RETURN:          PointerResult, with data set to pointer to element if ok.
 ////
 PointerResult cs_vector_get(Vector *vector, size_t index) {
-    if (index >= vector->size) {
-        return (PointerResult){
-            .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
-    }
-
-    return (PointerResult){.ok = true, .value = vector->container[index]};
+    return cs_vector_get_inline(vector, index);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -143,12 +166,7 @@ PointerResult cs_vector_get(Vector *vector, size_t index) {
 // RETURN:          VoidResult
 ////
 VoidResult cs_vector_set(Vector *vector, size_t index, void *user_data) {
-    if (index >= vector->size) {
-        return (VoidResult){.ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
-    }
-
-    vector->container[index] = user_data;
-    return (VoidResult){.ok = true, 0};
+    return cs_vector_set_inline(vector, index, user_data);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -190,7 +208,7 @@ PointerResult cs_vector_remove(Vector *vector, size_t index) {
     }
     void *value = vector->container[index];
     for (size_t i = index; i < vector->size - 1; ++i) {
-        vector->container[index] = vector->container[index + 1];
+        vector->container[i] = vector->container[i + 1];
     }
     vector->size -= 1;
     return (PointerResult){.ok = true, .value = value};
@@ -218,7 +236,9 @@ void cs_vector_free(Vector *vector) {
 ///////////////////////////////////////////////////////////////////////////////
 // FUNCTION:        cs_vector_iter
 //
-// DESCRIPTION:     Return an iterator to iterate over the container
+// DESCRIPTION:     Return an iterator to iterate over the container. If
+//                  vector->prefetch is set, the iterator prefetches elements
+//                  ahead of the one it returns.
 //
 // ARGUMENTS:       vector: The vector to iterate over.
 //
@@ -226,9 +246,43 @@ void cs_vector_free(Vector *vector) {
 ////
 Iterator cs_vector_iter(Vector *vector) {
     Iterator iter = {0};
-    iter.next = private_iter_next;
+    iter.next =
+        0 == vector->prefetch ? private_iter_next : private_iter_next_prefetch;
     iter.private = vector;
     return iter;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_vector_for_each
+//
+// DESCRIPTION:     Call visitor on each element of the vector, in order. This
+//                  is cheaper per element than an Iterator, and honors
+//                  vector->prefetch. The visitor must not modify the vector.
+//
+// ARGUMENTS:       visitor: Function to call on each element
+//                  context: Passed through to the visitor
+//
+// RETURN:          none
+////
+void cs_vector_for_each(Vector *vector, VisitFn *visitor, void *context) {
+    void **container = vector->container;
+    size_t size = vector->size;
+    size_t distance = vector->prefetch;
+    size_t i = 0;
+    if (0 != distance && size > distance) {
+        // Prime the window, then keep it full until the tail
+        for (size_t j = 0; j < distance; ++j) {
+            __builtin_prefetch(container[j]);
+        }
+        for (; i < size - distance; ++i) {
+            __builtin_prefetch(container[i + distance]);
+            visitor(container[i], context);
+        }
+    }
+
+    for (; i < size; ++i) {
+        visitor(container[i], context);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
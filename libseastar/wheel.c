@@ -0,0 +1,313 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            wheel.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the hierarchical timing wheel
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <libseastar/error.h>
+#include <libseastar/wheel.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+static const uint64_t CS_WHEEL_SLOT_MASK = (1 << CS_WHEEL_SLOT_BITS) - 1;
+
+// Unlink a timer from whichever list it's on
+static void priv_wheel_unlink(TimerWheel *wheel, TimerHandle *timer) {
+    if (wheel->expired_tail == &timer->next) {
+        wheel->expired_tail = timer->pprev;
+    }
+    *timer->pprev = timer->next;
+    if (NULL != timer->next) {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+// Unlink a timer, keeping track of the number of pending timers. Timers on the
+// expired list always expire on or before the current tick, and pending
+// timers always expire after it.
+static void priv_wheel_remove(TimerWheel *wheel, TimerHandle *timer) {
+    if (timer->expiry > wheel->tick) {
+        wheel->size -= 1;
+    }
+    priv_wheel_unlink(wheel, timer);
+}
+
+// Append a timer to the expired list
+static void priv_wheel_expire(TimerWheel *wheel, TimerHandle *timer) {
+    timer->next = NULL;
+    timer->pprev = wheel->expired_tail;
+    *wheel->expired_tail = timer;
+    wheel->expired_tail = &timer->next;
+}
+
+// Link a timer into the slot it belongs in, relative to the current tick
+static void priv_wheel_insert(TimerWheel *wheel, TimerHandle *timer) {
+    // Find the lowest level whose range covers the timer, or park it at the
+    // far end of the top level if none do.
+    uint64_t delta = timer->expiry - wheel->tick;
+    uint64_t expiry = timer->expiry;
+    unsigned int level = 0;
+    while (level < wheel->levels - 1
+        && delta >> (CS_WHEEL_SLOT_BITS * (level + 1)) > 0) {
+        level += 1;
+    }
+    if (delta >> (CS_WHEEL_SLOT_BITS * (level + 1)) > 0) {
+        expiry = wheel->tick
+            + ((uint64_t)1 << (CS_WHEEL_SLOT_BITS * (level + 1))) - 1;
+    }
+
+    size_t index = (level << CS_WHEEL_SLOT_BITS)
+        + ((expiry >> (CS_WHEEL_SLOT_BITS * level)) & CS_WHEEL_SLOT_MASK);
+    TimerHandle **slot = &wheel->slots[index];
+    timer->next = *slot;
+    timer->pprev = slot;
+    if (NULL != *slot) {
+        (*slot)->pprev = &timer->next;
+    }
+    *slot = timer;
+}
+
+// Re-insert every timer in a slot, relative to the current tick. Timers that
+// expire on the current tick land in the current level 0 slot.
+static void priv_wheel_cascade(TimerWheel *wheel, size_t index) {
+    TimerHandle *timer = wheel->slots[index];
+    wheel->slots[index] = NULL;
+    while (NULL != timer) {
+        TimerHandle *next = timer->next;
+        priv_wheel_insert(wheel, timer);
+        timer = next;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        private_iter_next
+//
+// DESCRIPTION:     Remove and return the next expired timer.
+//
+// ARGUMENTS:       private: The TimerWheel*
+//                  state: Unused
+//
+// RETURN:          The next expired TimerHandle, or NULL.
+////
+static void *private_iter_next(void *private, union IteratorState *state) {
+    (void)state;
+    TimerWheel *wheel = (TimerWheel *)private;
+    TimerHandle *timer = wheel->expired;
+    if (NULL != timer) {
+        priv_wheel_unlink(wheel, timer);
+    }
+    return timer;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wheel_init
+//
+// DESCRIPTION:     Initialize the wheel at time zero.
+//
+// ARGUMENTS:       resolution: The number of time units in one tick
+//                  levels: The number of levels in the hierarchy, between 1
+//                      and CS_WHEEL_MAX_LEVELS
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_wheel_init(TimerWheel *wheel, uint64_t resolution,
+    unsigned int levels) {
+    if (0 == resolution || 0 == levels || levels > CS_WHEEL_MAX_LEVELS) {
+        return (VoidResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_ARGUMENT};
+    }
+
+    wheel->resolution = resolution;
+    wheel->levels = levels;
+    wheel->tick = 0;
+    wheel->size = 0;
+    wheel->expired = NULL;
+    wheel->expired_tail = &wheel->expired;
+    wheel->slots = calloc((size_t)levels << CS_WHEEL_SLOT_BITS,
+        sizeof(TimerHandle *));
+    if (NULL == wheel->slots) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wheel_schedule
+//
+// DESCRIPTION:     Schedule the timer to fire once the wheel has been advanced
+//                  to expiry. If the timer is already pending, it is
+//                  rescheduled. Timers scheduled in the past fire on the next
+//                  tick.
+//
+// ARGUMENTS:       timer: The timer to schedule
+//                  expiry: The time at which the timer should fire
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_wheel_schedule(TimerWheel *wheel, TimerHandle *timer,
+    uint64_t expiry) {
+    if (NULL != timer->pprev) {
+        priv_wheel_remove(wheel, timer);
+    }
+
+    // Round up, so that the timer never fires early
+    timer->expiry = expiry / wheel->resolution
+        + (0 != expiry % wheel->resolution);
+    if (timer->expiry <= wheel->tick) {
+        timer->expiry = wheel->tick + 1;
+    }
+
+    priv_wheel_insert(wheel, timer);
+    wheel->size += 1;
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wheel_cancel
+//
+// DESCRIPTION:     Cancel the timer. Timers that have fired but have not yet
+//                  been collected through cs_wheel_iter are also removed.
+//
+// ARGUMENTS:       timer: The timer to cancel
+//
+// RETURN:          VoidResult, with SEASTAR_ERROR_NOT_SCHEDULED if the timer
+//                  was not pending.
+////
+VoidResult cs_wheel_cancel(TimerWheel *wheel, TimerHandle *timer) {
+    if (NULL == timer->pprev) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERROR_NOT_SCHEDULED};
+    }
+
+    priv_wheel_remove(wheel, timer);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wheel_advance
+//
+// DESCRIPTION:     Advance the wheel to now, moving every timer that expires
+//                  on or before now onto the expired list. The expired timers
+//                  can then be collected in one batch with cs_wheel_iter.
+//
+// ARGUMENTS:       now: The current time. Moving backwards is a no-op.
+//
+// RETURN:          IndexResult containing the number of timers that fired.
+////
+IndexResult cs_wheel_advance(TimerWheel *wheel, uint64_t now) {
+    uint64_t target = now / wheel->resolution;
+    size_t fired = 0;
+    while (wheel->tick < target) {
+        if (0 == wheel->size) {
+            wheel->tick = target;
+            break;
+        }
+
+        wheel->tick += 1;
+
+        // Every time a level wraps around, pull the timers in the next
+        // level's current slot down into range.
+        for (unsigned int level = 1; level < wheel->levels; ++level) {
+            uint64_t lower = wheel->tick >> (CS_WHEEL_SLOT_BITS * (level - 1));
+            if (0 != (lower & CS_WHEEL_SLOT_MASK)) {
+                break;
+            }
+            uint64_t index = (wheel->tick >> (CS_WHEEL_SLOT_BITS * level))
+                & CS_WHEEL_SLOT_MASK;
+            priv_wheel_cascade(wheel, (level << CS_WHEEL_SLOT_BITS) + index);
+        }
+
+        // Timers parked in a single-level wheel may still be out of range
+        size_t index = wheel->tick & CS_WHEEL_SLOT_MASK;
+        TimerHandle *timer = wheel->slots[index];
+        wheel->slots[index] = NULL;
+        while (NULL != timer) {
+            TimerHandle *next = timer->next;
+            if (timer->expiry > wheel->tick) {
+                priv_wheel_insert(wheel, timer);
+            } else {
+                priv_wheel_expire(wheel, timer);
+                wheel->size -= 1;
+                fired += 1;
+            }
+            timer = next;
+        }
+    }
+
+    return (IndexResult){.ok = true, .value = fired};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wheel_free
+//
+// DESCRIPTION:     Free internally allocated memory for the wheel. Timers are
+//                  owned by the user, and are not touched.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_wheel_free(TimerWheel *wheel) {
+    if (NULL != wheel->slots) {
+        free(wheel->slots);
+        wheel->slots = NULL;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wheel_iter
+//
+// DESCRIPTION:     Return an iterator that removes and yields each expired
+//                  TimerHandle, in the order in which they fired. Yielded
+//                  timers are no longer pending, and may be rescheduled or
+//                  freed.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          Iterator
+////
+Iterator cs_wheel_iter(TimerWheel *wheel) {
+    Iterator iter = {0};
+    iter.next = private_iter_next;
+    iter.private = wheel;
+    return iter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
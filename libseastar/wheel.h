@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            wheel.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Hierarchical timing wheel for scheduling timeouts
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_WHEEL_H
+#define SEASTAR_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libseastar/iterator.h>
+#include <libseastar/result.h>
+
+// Each level of the wheel has 1 << CS_WHEEL_SLOT_BITS slots, so level n
+// covers (1 << CS_WHEEL_SLOT_BITS)^(n + 1) ticks.
+static const unsigned int CS_WHEEL_SLOT_BITS = 6;
+static const unsigned int CS_WHEEL_MAX_LEVELS = 10;
+static const unsigned int CS_WHEEL_DEFAULT_LEVELS = 4;
+
+// A timer. The wheel is non-owning and intrusive: the user allocates handles
+// (e.g. embedded in a connection struct), and the wheel only links them
+// together. Handles must be zero-initialized before they are first scheduled,
+// and must not be freed while they are pending.
+typedef struct TimerHandle {
+    // USER CUSTOMIZABLE FIELDS
+    void *user_data;
+
+    // NON USER CUSTOMIZABLE FIELDS
+    uint64_t expiry;
+    struct TimerHandle *next;
+    struct TimerHandle **pprev;
+} TimerHandle;
+
+// TimerWheel: Schedules and cancels timers in O(1), regardless of the number
+// of pending timers. Time is measured in caller-defined units (e.g.
+// milliseconds since some epoch), and is quantized into ticks of resolution
+// units each. A timer never fires before its expiry time, but may fire up to
+// one tick after it. Timers further out than the wheel's range are parked in
+// the top level and re-cascaded until they come into range.
+typedef struct TimerWheel {
+    // NON USER CUSTOMIZABLE FIELDS
+    uint64_t resolution;
+    unsigned int levels;
+    uint64_t tick;
+    size_t size;
+    TimerHandle **slots;
+    TimerHandle *expired;
+    TimerHandle **expired_tail;
+} TimerWheel;
+
+// Initialize a wheel with the given tick resolution and number of levels
+VoidResult cs_wheel_init(TimerWheel *wheel, uint64_t resolution,
+    unsigned int levels);
+
+// Schedule the timer to fire at expiry. Pending timers are rescheduled.
+VoidResult cs_wheel_schedule(TimerWheel *wheel, TimerHandle *timer,
+    uint64_t expiry);
+
+// Cancel a pending or expired-but-uncollected timer
+VoidResult cs_wheel_cancel(TimerWheel *wheel, TimerHandle *timer);
+
+// Advance the wheel to now, returning the number of timers that fired
+IndexResult cs_wheel_advance(TimerWheel *wheel, uint64_t now);
+
+// Free internally allocated memory. Pending timers are forgotten.
+void cs_wheel_free(TimerWheel *wheel);
+
+// Create an iterator that removes and yields the TimerHandles that fired
+Iterator cs_wheel_iter(TimerWheel *wheel);
+
+#endif // SEASTAR_WHEEL_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,245 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            wsdeque.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the work-stealing deque
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <libseastar/error.h>
+#include <libseastar/wsdeque.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Interface
+////
+
+// A circular buffer. Slots are atomic because a thief may read a slot while
+// the owner overwrites it after wrapping around; the thief's CAS on top then
+// fails, and the value it read is discarded.
+typedef struct WorkDequeArray {
+    size_t mask;
+    struct WorkDequeArray *retired;
+    _Atomic(void *) buffer[];
+} WorkDequeArray;
+
+static WorkDequeArray *priv_wsdeque_array(size_t capacity) {
+    WorkDequeArray *array =
+        malloc(sizeof(WorkDequeArray) + capacity * sizeof(_Atomic(void *)));
+    if (NULL != array) {
+        array->mask = capacity - 1;
+        array->retired = NULL;
+    }
+    return array;
+}
+
+// Double the capacity of the array, copying over the live elements. Owner
+// only.
+static WorkDequeArray *priv_wsdeque_grow(WorkDeque *deque,
+    WorkDequeArray *array, int64_t top, int64_t bottom) {
+    WorkDequeArray *grown = priv_wsdeque_array(2 * (array->mask + 1));
+    if (NULL == grown) {
+        return NULL;
+    }
+
+    for (int64_t i = top; i < bottom; ++i) {
+        void *value = atomic_load_explicit(
+            &array->buffer[i & array->mask], memory_order_relaxed);
+        atomic_store_explicit(
+            &grown->buffer[i & grown->mask], value, memory_order_relaxed);
+    }
+
+    grown->retired = array;
+    atomic_store_explicit(&deque->array, grown, memory_order_release);
+    return grown;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Interface
+////
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wsdeque_init
+//
+// DESCRIPTION:     Initialize an empty deque
+//
+// ARGUMENTS:       capacity: The initial capacity, or 0
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_wsdeque_init(WorkDeque *deque, size_t capacity) {
+    size_t size = 1;
+    capacity = 0 == capacity ? CS_WSDEQUE_DEFAULT_SIZE : capacity;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    WorkDequeArray *array = priv_wsdeque_array(size);
+    if (NULL == array) {
+        return (VoidResult){.ok = false, .error = SEASTAR_ERRNO_SET | errno};
+    }
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->array, array);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wsdeque_push
+//
+// DESCRIPTION:     Push an element onto the bottom of the deque, growing it if
+//                  it is full. Must only be called by the owner.
+//
+// ARGUMENTS:       user_data: The element to push
+//
+// RETURN:          VoidResult
+////
+VoidResult cs_wsdeque_push(WorkDeque *deque, void *user_data) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    WorkDequeArray *array =
+        atomic_load_explicit(&deque->array, memory_order_relaxed);
+    if (bottom - top > (int64_t)array->mask) {
+        array = priv_wsdeque_grow(deque, array, top, bottom);
+        if (NULL == array) {
+            return (VoidResult){
+                .ok = false, .error = SEASTAR_ERRNO_SET | errno};
+        }
+    }
+
+    atomic_store_explicit(
+        &array->buffer[bottom & array->mask], user_data, memory_order_relaxed);
+
+    // Release, so that a thief that sees the new bottom also sees the element
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return (VoidResult){.ok = true, 0};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wsdeque_pop
+//
+// DESCRIPTION:     Pop the most recently pushed element from the bottom of
+//                  the deque. Must only be called by the owner.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          PointerResult containing the element, or
+//                  SEASTAR_ERROR_INVALID_INDEX if the deque is empty.
+////
+PointerResult cs_wsdeque_pop(WorkDeque *deque) {
+    int64_t bottom =
+        atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    WorkDequeArray *array =
+        atomic_load_explicit(&deque->array, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+
+    // Order the store to bottom before the load of top, pairing with the
+    // fence in cs_wsdeque_steal, so that the owner and a thief can't both
+    // take the last element.
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return (PointerResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    void *value = atomic_load_explicit(
+        &array->buffer[bottom & array->mask], memory_order_relaxed);
+    if (top == bottom) {
+        // This is the last element, so race the thieves for it
+        bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top,
+            top + 1, memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        if (!won) {
+            return (PointerResult){
+                .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+        }
+    }
+
+    return (PointerResult){.ok = true, .value = value};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wsdeque_steal
+//
+// DESCRIPTION:     Steal the oldest element from the top of the deque. Safe
+//                  to call from any thread.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          PointerResult containing the element. If the deque is
+//                  empty, the error is SEASTAR_ERROR_INVALID_INDEX. If another
+//                  thread took the element first, the error is
+//                  SEASTAR_ERROR_CONTENDED, and the caller may retry.
+////
+PointerResult cs_wsdeque_steal(WorkDeque *deque) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) {
+        return (PointerResult){
+            .ok = false, .error = SEASTAR_ERROR_INVALID_INDEX};
+    }
+
+    WorkDequeArray *array =
+        atomic_load_explicit(&deque->array, memory_order_acquire);
+    void *value = atomic_load_explicit(
+        &array->buffer[top & array->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+            memory_order_seq_cst, memory_order_relaxed)) {
+        return (PointerResult){.ok = false, .error = SEASTAR_ERROR_CONTENDED};
+    }
+
+    return (PointerResult){.ok = true, .value = value};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// FUNCTION:        cs_wsdeque_free
+//
+// DESCRIPTION:     Free the deque's array, and every array it has outgrown.
+//                  Elements are owned by the user, and are not touched.
+//
+// ARGUMENTS:       none
+//
+// RETURN:          none
+////
+void cs_wsdeque_free(WorkDeque *deque) {
+    WorkDequeArray *array =
+        atomic_load_explicit(&deque->array, memory_order_relaxed);
+    while (NULL != array) {
+        WorkDequeArray *retired = array->retired;
+        free(array);
+        array = retired;
+    }
+    atomic_store_explicit(&deque->array, NULL, memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
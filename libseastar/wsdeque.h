@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            wsdeque.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Lock-free Chase-Lev work-stealing deque
+//
+// CREATED:         10/19/2026
+//
+// LAST EDITED:     10/19/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SEASTAR_WSDEQUE_H
+#define SEASTAR_WSDEQUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libseastar/result.h>
+
+static const size_t CS_WSDEQUE_DEFAULT_SIZE = 64;
+
+struct WorkDequeArray;
+
+// WorkDeque: Chase-Lev work-stealing deque (as formulated for C11 atomics by
+// Le et al., 2013). A single owner thread pushes and pops at the bottom,
+// while any number of thief threads steal from the top, all without locks.
+// The deque grows when full. Arrays that have been outgrown are kept until
+// the deque is freed, since a thief may still be reading from one.
+//
+// top and bottom sit on separate cache lines, so that thieves bumping top do
+// not invalidate the line the owner is pushing and popping through.
+typedef struct WorkDeque {
+    // NON USER CUSTOMIZABLE FIELDS
+    _Alignas(64) _Atomic int64_t top;
+    _Alignas(64) _Atomic int64_t bottom;
+    _Atomic(struct WorkDequeArray *) array;
+} WorkDeque;
+
+// Initialize a deque. The capacity is rounded up to a power of two, and a
+// capacity of 0 selects the default.
+VoidResult cs_wsdeque_init(WorkDeque *deque, size_t capacity);
+
+// Push onto the bottom of the deque. Owner only.
+VoidResult cs_wsdeque_push(WorkDeque *deque, void *user_data);
+
+// Pop from the bottom of the deque. Owner only.
+PointerResult cs_wsdeque_pop(WorkDeque *deque);
+
+// Steal from the top of the deque. Safe from any thread.
+PointerResult cs_wsdeque_steal(WorkDeque *deque);
+
+// Free internally allocated memory. No thread may be using the deque.
+void cs_wsdeque_free(WorkDeque *deque);
+
+#endif // SEASTAR_WSDEQUE_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         11/13/2021
 //
-// LAST EDITED:     11/13/2021
+// LAST EDITED:     10/19/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -32,11 +32,28 @@
 
 #include <stdarg.h>
 #define _GNU_SOURCE
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
+#include <libseastar/bitset.h>
+#include <libseastar/btree.h>
+#include <libseastar/error.h>
+#include <libseastar/extqueue.h>
+#include <libseastar/merge.h>
+#include <libseastar/parallel.h>
+#include <libseastar/pool.h>
 #include <libseastar/pqueue.h>
+#include <libseastar/reactor.h>
+#include <libseastar/snapshot.h>
+#include <libseastar/sorted.h>
 #include <libseastar/vector.h>
+#include <libseastar/wheel.h>
+#include <libseastar/wsdeque.h>
 
 void assert(bool test, const char *message, ...) {
     if (!test) {
@@ -65,6 +82,10 @@ void print_int_vector(Vector *vector) {
     printf("\n");
 }
 
+void sum_int(void *user_data, void *context) {
+    *(int *)context += *(int *)user_data;
+}
+
 void test_vector() {
     Vector vector;
     cs_vector_init(&vector);
@@ -87,12 +108,53 @@ void test_vector() {
     assert(NULL == cs_iter_next(&vector_iter),
         "cs_iter_next did not return NULL");
 
+    int total = 0;
+    cs_vector_for_each(&vector, sum_int, &total);
+    assert(total == datum, "cs_vector_for_each did not visit the element");
+
     pointer_result = cs_vector_remove(&vector, 0);
     assert(pointer_result.ok, "cs_vector_remove failed");
     assert(*(int *)pointer_result.value == datum,
         "cs_vector_remove returned the wrong element");
     assert(vector.size == 0, "vector size is wrong");
 
+    // Removing from the middle shifts the tail down in order
+    Vector middle;
+    cs_vector_init(&middle);
+    int values[] = {1, 2, 3, 4};
+    for (size_t i = 0; i < 4; ++i) {
+        cs_vector_push_back(&middle, &values[i]);
+    }
+    pointer_result = cs_vector_remove(&middle, 1);
+    assert(pointer_result.ok && *(int *)pointer_result.value == 2,
+        "cs_vector_remove returned the wrong element");
+    assert(middle.size == 3, "vector size is wrong");
+    int remaining[] = {1, 3, 4};
+    for (size_t i = 0; i < 3; ++i) {
+        assert(*(int *)cs_vector_get(&middle, i).value == remaining[i],
+            "cs_vector_remove left the tail out of order");
+    }
+    cs_vector_free(&middle);
+
+    // Traversals with prefetching enabled visit the same elements
+    int data[50];
+    for (int i = 0; i < 50; ++i) {
+        data[i] = i;
+        cs_vector_push_back(&vector, &data[i]);
+    }
+    vector.prefetch = CS_VECTOR_DEFAULT_PREFETCH;
+    total = 0;
+    cs_vector_for_each(&vector, sum_int, &total);
+    assert(total == 49 * 50 / 2,
+        "cs_vector_for_each visited the wrong elements");
+    vector_iter = cs_vector_iter(&vector);
+    for (int i = 0; i < 50; ++i) {
+        assert(*(int *)cs_iter_next(&vector_iter) == i,
+            "prefetching iterator returned the wrong element");
+    }
+    assert(NULL == cs_iter_next(&vector_iter),
+        "cs_iter_next did not return NULL");
+
     cs_vector_free(&vector);
 }
 
@@ -148,9 +210,949 @@ void test_pqueue() {
     assert(1 == pqueue.container.size, "Pqueue has wrong size!");
 }
 
+void test_merge() {
+    int data[] = {1, 4, 7, 10, 2, 5, 8, 3, 6, 9, 11, 12};
+    Vector sources[4];
+    for (size_t i = 0; i < 4; ++i) {
+        cs_vector_init(&sources[i]);
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        cs_vector_push_back(&sources[0], &data[i]);
+    }
+    for (size_t i = 4; i < 7; ++i) {
+        cs_vector_push_back(&sources[1], &data[i]);
+    }
+    for (size_t i = 7; i < 12; ++i) {
+        cs_vector_push_back(&sources[2], &data[i]);
+    }
+    // sources[3] is left empty
+
+    Iterator iterators[4];
+    for (size_t i = 0; i < 4; ++i) {
+        iterators[i] = cs_vector_iter(&sources[i]);
+    }
+
+    MergeIterator merge;
+    VoidResult result =
+        cs_merge_init(&merge, iterators, 4, example_comparator);
+    assert(result.ok, "cs_merge_init returned error");
+
+    Iterator merge_iter = cs_merge_iter(&merge);
+    for (int expected = 1; expected <= 12; ++expected) {
+        int *value = cs_iter_next(&merge_iter);
+        assert(NULL != value, "cs_iter_next ended early at %d", expected);
+        assert(*value == expected, "line %d: cs_iter_next, expected=%d, got=%d",
+            __LINE__, expected, *value);
+    }
+    assert(NULL == cs_iter_next(&merge_iter),
+        "cs_iter_next did not return NULL");
+
+    cs_merge_free(&merge);
+    for (size_t i = 0; i < 4; ++i) {
+        cs_vector_free(&sources[i]);
+    }
+}
+
+void test_wheel() {
+    TimerWheel wheel;
+    VoidResult result = cs_wheel_init(&wheel, 1, CS_WHEEL_DEFAULT_LEVELS);
+    assert(result.ok, "cs_wheel_init returned error");
+
+    TimerHandle first = {0}, second = {0}, third = {0};
+    cs_wheel_schedule(&wheel, &first, 5);
+    cs_wheel_schedule(&wheel, &second, 100);
+    cs_wheel_schedule(&wheel, &third, 5000);
+    assert(3 == wheel.size, "wheel has wrong size");
+
+    result = cs_wheel_cancel(&wheel, &second);
+    assert(result.ok, "cs_wheel_cancel returned error");
+    result = cs_wheel_cancel(&wheel, &second);
+    assert(!result.ok && SEASTAR_ERROR_NOT_SCHEDULED == result.error,
+        "cs_wheel_cancel did not return SEASTAR_ERROR_NOT_SCHEDULED");
+
+    IndexResult index_result = cs_wheel_advance(&wheel, 4);
+    assert(index_result.ok && 0 == index_result.value,
+        "line %d: cs_wheel_advance, expected=%d, got=%d", __LINE__, 0,
+        index_result.value);
+
+    index_result = cs_wheel_advance(&wheel, 5);
+    assert(1 == index_result.value,
+        "line %d: cs_wheel_advance, expected=%d, got=%d", __LINE__, 1,
+        index_result.value);
+    Iterator expired = cs_wheel_iter(&wheel);
+    assert(&first == cs_iter_next(&expired),
+        "cs_iter_next did not return the expired timer");
+    assert(NULL == cs_iter_next(&expired), "cs_iter_next did not return NULL");
+
+    index_result = cs_wheel_advance(&wheel, 4999);
+    assert(0 == index_result.value, "timer fired early");
+    index_result = cs_wheel_advance(&wheel, 5000);
+    assert(1 == index_result.value, "timer did not fire");
+    assert(&third == cs_iter_next(&expired),
+        "cs_iter_next did not return the expired timer");
+    assert(0 == wheel.size, "wheel has wrong size");
+    cs_wheel_free(&wheel);
+
+    // Timers beyond the range of the wheel are re-cascaded until they fire
+    cs_wheel_init(&wheel, 10, 1);
+    cs_wheel_schedule(&wheel, &first, 10001);
+    index_result = cs_wheel_advance(&wheel, 10009);
+    assert(0 == index_result.value, "out-of-range timer fired early");
+    index_result = cs_wheel_advance(&wheel, 10010);
+    assert(1 == index_result.value, "out-of-range timer did not fire");
+    cs_wheel_free(&wheel);
+}
+
+void test_bitset() {
+    BitSet bitset, other;
+    VoidResult result = cs_bitset_init(&bitset, 200);
+    assert(result.ok, "cs_bitset_init returned error");
+    cs_bitset_init(&other, 200);
+
+    const size_t indices[] = {0, 63, 64, 130, 199};
+    for (size_t i = 0; i < 5; ++i) {
+        result = cs_bitset_set(&bitset, indices[i]);
+        assert(result.ok, "cs_bitset_set returned error");
+    }
+    result = cs_bitset_set(&bitset, 200);
+    assert(!result.ok, "cs_bitset_set did not return error");
+
+    BoolResult bool_result = cs_bitset_test(&bitset, 64);
+    assert(bool_result.ok && bool_result.value, "bit 64 is not set");
+    bool_result = cs_bitset_test(&bitset, 65);
+    assert(bool_result.ok && !bool_result.value, "bit 65 is set");
+    assert(5 == cs_bitset_count(&bitset), "cs_bitset_count is wrong");
+
+    IndexResult index_result = cs_bitset_rank(&bitset, 130);
+    assert(index_result.ok && 3 == index_result.value,
+        "line %d: cs_bitset_rank, expected=%d, got=%d", __LINE__, 3,
+        index_result.value);
+    index_result = cs_bitset_select(&bitset, 3);
+    assert(index_result.ok && 130 == index_result.value,
+        "line %d: cs_bitset_select, expected=%d, got=%d", __LINE__, 130,
+        index_result.value);
+    index_result = cs_bitset_select(&bitset, 5);
+    assert(!index_result.ok, "cs_bitset_select did not return error");
+
+    Iterator bitset_iter = cs_bitset_iter(&bitset);
+    for (size_t i = 0; i < 5; ++i) {
+        void *value = cs_iter_next(&bitset_iter);
+        assert(NULL != value && indices[i] == CS_BITSET_INDEX(value),
+            "cs_iter_next did not return the correct index");
+    }
+    assert(NULL == cs_iter_next(&bitset_iter),
+        "cs_iter_next did not return NULL");
+
+    cs_bitset_set(&other, 63);
+    cs_bitset_set(&other, 100);
+    cs_bitset_and(&other, &bitset);
+    assert(1 == cs_bitset_count(&other), "cs_bitset_and is wrong");
+    cs_bitset_or(&other, &bitset);
+    assert(5 == cs_bitset_count(&other), "cs_bitset_or is wrong");
+    cs_bitset_clear(&other, 0);
+    cs_bitset_xor(&other, &bitset);
+    assert(1 == cs_bitset_count(&other), "cs_bitset_xor is wrong");
+    cs_bitset_andnot(&other, &bitset);
+    assert(0 == cs_bitset_count(&other), "cs_bitset_andnot is wrong");
+
+    cs_bitset_resize(&bitset, 100);
+    assert(3 == cs_bitset_count(&bitset), "cs_bitset_resize did not trim");
+    cs_bitset_resize(&bitset, 300);
+    assert(3 == cs_bitset_count(&bitset), "cs_bitset_resize did not clear");
+
+    cs_bitset_free(&bitset);
+    cs_bitset_free(&other);
+}
+
+void test_pool() {
+    ObjectPool pool;
+    VoidResult result = cs_pool_init(&pool, sizeof(int), 16);
+    assert(result.ok, "cs_pool_init returned error");
+
+    int *objects[40];
+    for (int i = 0; i < 40; ++i) {
+        PointerResult pointer_result = cs_pool_alloc(&pool);
+        assert(pointer_result.ok, "cs_pool_alloc returned error");
+        objects[i] = pointer_result.value;
+        *objects[i] = i;
+    }
+    for (int i = 0; i < 40; ++i) {
+        assert(*objects[i] == i, "line %d: object, expected=%d, got=%d",
+            __LINE__, i, *objects[i]);
+    }
+
+    cs_pool_release(&pool, objects[7]);
+    PointerResult pointer_result = cs_pool_alloc(&pool);
+    assert(pointer_result.value == objects[7],
+        "cs_pool_alloc did not reuse a released object");
+
+    PoolCache cache;
+    cs_pool_cache_init(&cache, &pool, 4);
+    for (int i = 0; i < 10; ++i) {
+        cs_pool_cache_release(&cache, objects[i]);
+    }
+    assert(cache.size <= 4, "cache exceeded its capacity");
+    for (int i = 0; i < 10; ++i) {
+        pointer_result = cs_pool_cache_alloc(&cache);
+        assert(pointer_result.ok, "cs_pool_cache_alloc returned error");
+        objects[i] = pointer_result.value;
+    }
+    cs_pool_cache_free(&cache);
+    assert(0 == cache.size, "cache was not emptied");
+
+    cs_pool_free(&pool);
+}
+
+void test_sorted() {
+    SortedVector sorted;
+    VoidResult result = cs_sorted_init(&sorted, example_comparator);
+    assert(result.ok, "cs_sorted_init returned error");
+
+    int data[30];
+    Vector elements;
+    cs_vector_init(&elements);
+    for (int i = 0; i < 15; ++i) {
+        data[i] = (i * 7) % 15 * 2; // Even numbers 0-28, shuffled
+        cs_vector_push_back(&elements, &data[i]);
+    }
+    result = cs_sorted_build(&sorted, &elements);
+    assert(result.ok, "cs_sorted_build returned error");
+
+    // Merge in the odd numbers
+    elements.size = 0;
+    for (int i = 15; i < 30; ++i) {
+        data[i] = (i - 15) * 2 + 1;
+        cs_vector_push_back(&elements, &data[i]);
+    }
+    result = cs_sorted_merge(&sorted, &elements);
+    assert(result.ok, "cs_sorted_merge returned error");
+    cs_vector_free(&elements);
+
+    for (int frozen = 0; frozen < 2; ++frozen) {
+        Iterator sorted_iter = cs_sorted_iter(&sorted);
+        for (int i = 0; i < 30; ++i) {
+            int *value = cs_iter_next(&sorted_iter);
+            assert(*value == i, "line %d: cs_iter_next, expected=%d, got=%d",
+                __LINE__, i, *value);
+        }
+
+        int key = 10, missing = 31;
+        IndexResult index_result = cs_sorted_lower_bound(&sorted, &key);
+        assert(10 == index_result.value, "cs_sorted_lower_bound is wrong");
+        index_result = cs_sorted_upper_bound(&sorted, &key);
+        assert(11 == index_result.value, "cs_sorted_upper_bound is wrong");
+        PointerResult pointer_result = cs_sorted_find(&sorted, &key);
+        assert(pointer_result.ok && 10 == *(int *)pointer_result.value,
+            "cs_sorted_find did not find the key");
+        pointer_result = cs_sorted_find(&sorted, &missing);
+        assert(!pointer_result.ok, "cs_sorted_find found a missing key");
+
+        int low = 5, high = 8;
+        SortedRange range = cs_sorted_range(&sorted, &low, &high);
+        Iterator range_iter = cs_sorted_range_iter(&range);
+        for (int i = low; i <= high; ++i) {
+            int *value = cs_iter_next(&range_iter);
+            assert(NULL != value && *value == i,
+                "cs_sorted_range_iter returned the wrong element");
+        }
+        assert(NULL == cs_iter_next(&range_iter),
+            "cs_sorted_range_iter did not return NULL");
+
+        result = cs_sorted_freeze(&sorted);
+        assert(result.ok, "cs_sorted_freeze returned error");
+    }
+
+    int extra = 12;
+    IndexResult index_result = cs_sorted_insert(&sorted, &extra);
+    assert(index_result.ok && 13 == index_result.value,
+        "cs_sorted_insert returned the wrong index");
+    PointerResult pointer_result = cs_sorted_remove(&sorted, 13);
+    assert(pointer_result.value == &extra, "cs_sorted_remove is wrong");
+    pointer_result = cs_sorted_get(&sorted, 13);
+    assert(13 == *(int *)pointer_result.value, "cs_sorted_remove is wrong");
+
+    cs_sorted_free(&sorted);
+}
+
+void test_btree() {
+    BTree tree;
+    VoidResult result = cs_btree_init(&tree, example_comparator);
+    assert(result.ok, "cs_btree_init returned error");
+
+    // Enough keys for the tree to grow to three levels
+    static int keys[500];
+    for (int i = 0; i < 500; ++i) {
+        keys[i] = (i * 7) % 500;
+        PointerResult pointer_result =
+            cs_btree_insert(&tree, &keys[i], &keys[i]);
+        assert(pointer_result.ok && NULL == pointer_result.value,
+            "cs_btree_insert returned error");
+    }
+    assert(500 == tree.size, "tree has wrong size");
+    assert(2 == tree.height, "line %d: tree height, expected=%d, got=%d",
+        __LINE__, 2, tree.height);
+
+    int key = 123;
+    PointerResult pointer_result = cs_btree_get(&tree, &key);
+    assert(pointer_result.ok && 123 == *(int *)pointer_result.value,
+        "cs_btree_get returned the wrong value");
+
+    // Remove the odd keys
+    for (int i = 1; i < 500; i += 2) {
+        pointer_result = cs_btree_remove(&tree, &i);
+        assert(pointer_result.ok && i == *(int *)pointer_result.value,
+            "cs_btree_remove returned the wrong value");
+    }
+    pointer_result = cs_btree_get(&tree, &key);
+    assert(!pointer_result.ok, "cs_btree_get found a removed key");
+
+    int low = 100, high = 120;
+    BTreeRange range = cs_btree_range(&tree, &low, &high);
+    Iterator range_iter = cs_btree_range_iter(&range);
+    for (int i = low; i <= high; i += 2) {
+        int *value = cs_iter_next(&range_iter);
+        assert(NULL != value && *value == i,
+            "cs_btree_range_iter returned the wrong value");
+        assert(*(int *)range.key == i, "range key is wrong");
+    }
+    assert(NULL == cs_iter_next(&range_iter),
+        "cs_btree_range_iter did not return NULL");
+
+    // Bulk load replaces the contents of the tree
+    Vector sorted_keys;
+    cs_vector_init(&sorted_keys);
+    static int sorted[100];
+    for (int i = 0; i < 100; ++i) {
+        sorted[i] = i;
+        cs_vector_push_back(&sorted_keys, &sorted[i]);
+    }
+    result = cs_btree_bulk_load(&tree, &sorted_keys, &sorted_keys);
+    assert(result.ok, "cs_btree_bulk_load returned error");
+    assert(100 == tree.size, "tree has wrong size");
+    range = cs_btree_range(&tree, NULL, NULL);
+    range_iter = cs_btree_range_iter(&range);
+    for (int i = 0; i < 100; ++i) {
+        int *value = cs_iter_next(&range_iter);
+        assert(NULL != value && *value == i,
+            "cs_btree_range_iter returned the wrong value");
+    }
+    assert(NULL == cs_iter_next(&range_iter),
+        "cs_btree_range_iter did not return NULL");
+
+    cs_vector_free(&sorted_keys);
+    cs_btree_free(&tree);
+
+    // Removed keys may be freed by the caller. Lookups must never compare
+    // against them, whether the tree was built by insertion or bulk load.
+    for (int bulk = 0; bulk < 2; ++bulk) {
+        cs_btree_init(&tree, example_comparator);
+        int *owned[500];
+        cs_vector_init(&sorted_keys);
+        for (int i = 0; i < 500; ++i) {
+            owned[i] = malloc(sizeof(int));
+            *owned[i] = i;
+            cs_vector_push_back(&sorted_keys, owned[i]);
+        }
+        if (bulk) {
+            cs_btree_bulk_load(&tree, &sorted_keys, &sorted_keys);
+        } else {
+            for (int i = 0; i < 500; ++i) {
+                int *inserted = owned[(i * 7) % 500];
+                cs_btree_insert(&tree, inserted, inserted);
+            }
+        }
+        cs_vector_free(&sorted_keys);
+
+        for (int i = 0; i < 500; i += 3) {
+            pointer_result = cs_btree_remove(&tree, owned[i]);
+            assert(pointer_result.ok && owned[i] == pointer_result.value,
+                "cs_btree_remove returned the wrong value");
+            free(owned[i]);
+        }
+        for (int i = 0; i < 500; ++i) {
+            pointer_result = cs_btree_get(&tree, &i);
+            assert(pointer_result.ok == (0 != i % 3),
+                "line %d: cs_btree_get(%d) after removals", __LINE__, i);
+        }
+        for (int i = 1; i < 500; ++i) {
+            if (0 != i % 3) {
+                pointer_result = cs_btree_remove(&tree, owned[i]);
+                assert(pointer_result.ok,
+                    "cs_btree_remove did not find a remaining key");
+                free(owned[i]);
+            }
+        }
+        assert(0 == tree.size && 0 == tree.height,
+            "tree did not shrink back to an empty leaf");
+        cs_btree_free(&tree);
+    }
+}
+
+#define WSDEQUE_STRESS_ITEMS 100000
+#define WSDEQUE_STRESS_THIEVES 3
+
+typedef struct WorkDequeStress {
+    WorkDeque deque;
+    atomic_bool done;
+    atomic_int taken[WSDEQUE_STRESS_ITEMS];
+    size_t items[WSDEQUE_STRESS_ITEMS];
+} WorkDequeStress;
+
+void *wsdeque_thief(void *argument) {
+    WorkDequeStress *stress = argument;
+    while (true) {
+        bool done = atomic_load(&stress->done);
+        PointerResult result = cs_wsdeque_steal(&stress->deque);
+        if (result.ok) {
+            atomic_fetch_add(&stress->taken[*(size_t *)result.value], 1);
+        } else if (done && SEASTAR_ERROR_INVALID_INDEX == result.error) {
+            return NULL;
+        }
+    }
+}
+
+void test_wsdeque() {
+    WorkDeque deque;
+    VoidResult result = cs_wsdeque_init(&deque, 2);
+    assert(result.ok, "cs_wsdeque_init returned error");
+
+    int data[10];
+    for (int i = 0; i < 10; ++i) {
+        data[i] = i;
+        result = cs_wsdeque_push(&deque, &data[i]);
+        assert(result.ok, "cs_wsdeque_push returned error");
+    }
+
+    // The owner pops LIFO, and thieves steal FIFO
+    PointerResult pointer_result = cs_wsdeque_pop(&deque);
+    assert(pointer_result.ok && 9 == *(int *)pointer_result.value,
+        "cs_wsdeque_pop returned the wrong element");
+    pointer_result = cs_wsdeque_steal(&deque);
+    assert(pointer_result.ok && 0 == *(int *)pointer_result.value,
+        "cs_wsdeque_steal returned the wrong element");
+    for (int i = 8; i >= 1; --i) {
+        pointer_result = cs_wsdeque_pop(&deque);
+        assert(pointer_result.ok && i == *(int *)pointer_result.value,
+            "cs_wsdeque_pop returned the wrong element");
+    }
+    pointer_result = cs_wsdeque_pop(&deque);
+    assert(!pointer_result.ok, "cs_wsdeque_pop did not return error");
+    pointer_result = cs_wsdeque_steal(&deque);
+    assert(!pointer_result.ok, "cs_wsdeque_steal did not return error");
+    cs_wsdeque_free(&deque);
+
+    // Stress test: the owner pushes every item and pops some of them back,
+    // while thieves steal the rest. Every item must be taken exactly once.
+    WorkDequeStress *stress = calloc(1, sizeof(WorkDequeStress));
+    cs_wsdeque_init(&stress->deque, 2);
+    atomic_init(&stress->done, false);
+    pthread_t thieves[WSDEQUE_STRESS_THIEVES];
+    for (int i = 0; i < WSDEQUE_STRESS_THIEVES; ++i) {
+        pthread_create(&thieves[i], NULL, wsdeque_thief, stress);
+    }
+
+    for (size_t i = 0; i < WSDEQUE_STRESS_ITEMS; ++i) {
+        stress->items[i] = i;
+        cs_wsdeque_push(&stress->deque, &stress->items[i]);
+        if (0 == i % 3) {
+            pointer_result = cs_wsdeque_pop(&stress->deque);
+            if (pointer_result.ok) {
+                atomic_fetch_add(
+                    &stress->taken[*(size_t *)pointer_result.value], 1);
+            }
+        }
+    }
+    atomic_store(&stress->done, true);
+    for (int i = 0; i < WSDEQUE_STRESS_THIEVES; ++i) {
+        pthread_join(thieves[i], NULL);
+    }
+
+    for (size_t i = 0; i < WSDEQUE_STRESS_ITEMS; ++i) {
+        int taken = atomic_load(&stress->taken[i]);
+        assert(1 == taken, "line %d: item %d taken %d times", __LINE__, (int)i,
+            taken);
+    }
+    cs_wsdeque_free(&stress->deque);
+    free(stress);
+}
+
+void parallel_sum(void *user_data, void *context) {
+    atomic_fetch_add((atomic_size_t *)context, *(int *)user_data);
+}
+
+void *parallel_double(void *user_data, void *context) {
+    (void)context;
+    return (void *)(uintptr_t)(2 * *(int *)user_data + 1);
+}
+
+void *parallel_reduce(void *accumulator, void *user_data, void *context) {
+    (void)context;
+    return (void *)((uintptr_t)accumulator + *(int *)user_data);
+}
+
+void *parallel_combine(void *left, void *right, void *context) {
+    (void)context;
+    return (void *)((uintptr_t)left + (uintptr_t)right);
+}
+
+void test_parallel() {
+    static const int size = 10000;
+    int *data = malloc(size * sizeof(int));
+    Vector vector, mapped;
+    cs_vector_init(&vector);
+    cs_vector_init(&mapped);
+    size_t expected = 0;
+    for (int i = 0; i < size; ++i) {
+        data[i] = i;
+        expected += i;
+        cs_vector_push_back(&vector, &data[i]);
+    }
+
+    ThreadPool pool;
+    VoidResult result = cs_threadpool_init(&pool, 4);
+    assert(result.ok, "cs_threadpool_init returned error");
+    ParallelSchedule schedules[] = {CS_PARALLEL_STATIC, CS_PARALLEL_DYNAMIC};
+    for (int s = 0; s < 2; ++s) {
+        pool.schedule = schedules[s];
+        pool.grain = 100;
+
+        atomic_size_t sum;
+        atomic_init(&sum, 0);
+        cs_vector_parallel_for_each(&pool, &vector, parallel_sum, &sum);
+        assert(expected == atomic_load(&sum),
+            "cs_vector_parallel_for_each missed elements");
+
+        result = cs_vector_parallel_map(
+            &pool, &vector, &mapped, parallel_double, NULL);
+        assert(result.ok && vector.size == mapped.size,
+            "cs_vector_parallel_map returned error");
+        for (int i = 0; i < size; ++i) {
+            uintptr_t value = (uintptr_t)cs_vector_get(&mapped, i).value;
+            assert(2 * (uintptr_t)i + 1 == value,
+                "line %d: mapped[%d] was %d", __LINE__, i, (int)value);
+        }
+
+        PointerResult reduced = cs_vector_parallel_reduce(
+            &pool, &vector, parallel_reduce, parallel_combine, NULL, NULL);
+        assert(reduced.ok && expected == (uintptr_t)reduced.value,
+            "cs_vector_parallel_reduce returned the wrong sum");
+    }
+
+    // Vectors no larger than the grain are processed on the caller alone
+    pool.grain = CS_THREADPOOL_DEFAULT_GRAIN;
+    vector.size = 10;
+    PointerResult reduced = cs_vector_parallel_reduce(
+        &pool, &vector, parallel_reduce, parallel_combine, NULL, NULL);
+    assert(reduced.ok && 45 == (uintptr_t)reduced.value,
+        "cs_vector_parallel_reduce returned the wrong sum");
+    result =
+        cs_vector_parallel_map(&pool, &vector, &vector, parallel_double, NULL);
+    assert(!result.ok, "cs_vector_parallel_map did not return error");
+
+    cs_threadpool_free(&pool);
+    cs_vector_free(&mapped);
+    cs_vector_free(&vector);
+    free(data);
+}
+
+#define SNAPSHOT_STRESS_UPDATES 20000
+#define SNAPSHOT_STRESS_READERS 3
+
+typedef struct SnapshotStress {
+    SnapshotVector snapshot;
+    atomic_bool done;
+    atomic_int errors;
+} SnapshotStress;
+
+// Every version published by the stress test holds (version % 16) + 1 copies
+// of its version number, so a reader can tell whether its view is consistent.
+void *snapshot_reader(void *argument) {
+    SnapshotStress *stress = argument;
+    SnapshotReader reader;
+    cs_snapshot_register(&stress->snapshot, &reader);
+    while (!atomic_load(&stress->done)) {
+        Vector *view = cs_snapshot_read_begin(&stress->snapshot, &reader);
+        if (view->size > 0) {
+            uintptr_t version = (uintptr_t)view->container[0];
+            if (version % 16 + 1 != view->size) {
+                atomic_fetch_add(&stress->errors, 1);
+            }
+            for (size_t i = 0; i < view->size; ++i) {
+                if ((uintptr_t)view->container[i] != version) {
+                    atomic_fetch_add(&stress->errors, 1);
+                }
+            }
+        }
+        cs_snapshot_read_end(&reader);
+    }
+    cs_snapshot_unregister(&stress->snapshot, &reader);
+    return NULL;
+}
+
+void test_snapshot() {
+    SnapshotVector snapshot;
+    VoidResult result = cs_snapshot_init(&snapshot);
+    assert(result.ok, "cs_snapshot_init returned error");
+    SnapshotReader reader;
+    cs_snapshot_register(&snapshot, &reader);
+
+    int data[3] = {1, 2, 3};
+    PointerResult pointer_result = cs_snapshot_write_begin(&snapshot);
+    assert(pointer_result.ok, "cs_snapshot_write_begin returned error");
+    for (int i = 0; i < 3; ++i) {
+        cs_vector_push_back(pointer_result.value, &data[i]);
+    }
+    cs_snapshot_publish(&snapshot);
+
+    // A reader keeps its view while the writer publishes a new version
+    Vector *view = cs_snapshot_read_begin(&snapshot, &reader);
+    assert(3 == view->size, "snapshot has the wrong size");
+    pointer_result = cs_snapshot_write_begin(&snapshot);
+    cs_vector_remove(pointer_result.value, 0);
+    cs_snapshot_publish(&snapshot);
+    assert(3 == view->size && &data[0] == view->container[0],
+        "snapshot was modified by the writer");
+    cs_snapshot_read_end(&reader);
+
+    view = cs_snapshot_read_begin(&snapshot, &reader);
+    assert(2 == view->size && &data[1] == view->container[0],
+        "snapshot does not reflect the published version");
+    cs_snapshot_read_end(&reader);
+
+    // An aborted update leaves the current version unchanged
+    pointer_result = cs_snapshot_write_begin(&snapshot);
+    cs_vector_push_back(pointer_result.value, &data[0]);
+    cs_snapshot_abort(&snapshot);
+    view = cs_snapshot_read_begin(&snapshot, &reader);
+    assert(2 == view->size, "aborted update was published");
+    cs_snapshot_read_end(&reader);
+
+    cs_snapshot_synchronize(&snapshot);
+    assert(NULL == snapshot.retired,
+        "cs_snapshot_synchronize did not reclaim retired versions");
+    cs_snapshot_unregister(&snapshot, &reader);
+    cs_snapshot_free(&snapshot);
+
+    // Stress test: readers scan the current version while the writer
+    // replaces it. Under AddressSanitizer, this also catches a version being
+    // reclaimed while a reader still holds it.
+    SnapshotStress *stress = calloc(1, sizeof(SnapshotStress));
+    cs_snapshot_init(&stress->snapshot);
+    atomic_init(&stress->done, false);
+    atomic_init(&stress->errors, 0);
+    pthread_t readers[SNAPSHOT_STRESS_READERS];
+    for (int i = 0; i < SNAPSHOT_STRESS_READERS; ++i) {
+        pthread_create(&readers[i], NULL, snapshot_reader, stress);
+    }
+
+    for (uintptr_t version = 1; version <= SNAPSHOT_STRESS_UPDATES; ++version) {
+        pointer_result = cs_snapshot_write_begin(&stress->snapshot);
+        Vector *draft = pointer_result.value;
+        draft->size = 0;
+        for (uintptr_t i = 0; i < version % 16 + 1; ++i) {
+            cs_vector_push_back(draft, (void *)version);
+        }
+        cs_snapshot_publish(&stress->snapshot);
+    }
+    atomic_store(&stress->done, true);
+    for (int i = 0; i < SNAPSHOT_STRESS_READERS; ++i) {
+        pthread_join(readers[i], NULL);
+    }
+
+    int errors = atomic_load(&stress->errors);
+    assert(0 == errors, "line %d: readers saw %d inconsistent snapshots",
+        __LINE__, errors);
+    cs_snapshot_free(&stress->snapshot);
+    free(stress);
+}
+
+typedef struct ExternalRecord {
+    int key;
+    int sequence;
+} ExternalRecord;
+
+int external_comparator(const void *one, const void *two) {
+    const ExternalRecord *left = one;
+    const ExternalRecord *right = two;
+    return (left->key > right->key) - (left->key < right->key);
+}
+
+void test_extqueue() {
+    static const int pushes = 5000;
+    ExternalQueue queue;
+    VoidResult result = cs_extqueue_init(
+        &queue, sizeof(ExternalRecord), 1, external_comparator);
+    assert(!result.ok, "cs_extqueue_init accepted a budget below one record");
+
+    // A budget of 16 records and a fan-in of 4 force frequent spills and
+    // merges of runs.
+    result = cs_extqueue_init(&queue, sizeof(ExternalRecord),
+        16 * sizeof(ExternalRecord), external_comparator);
+    assert(result.ok, "cs_extqueue_init returned error");
+    queue.fanin = 4;
+    queue.block_size = 64;
+
+    ExternalRecord record;
+    result = cs_extqueue_pop(&queue, &record);
+    assert(!result.ok, "cs_extqueue_pop on an empty queue did not fail");
+
+    // Interleave pushes of pseudo-random keys with pops. Every pop must
+    // return the least key in the queue, and every record must be popped
+    // exactly once.
+    char *popped = calloc(pushes, 1);
+    int counts[1000] = {0};
+    srand(3);
+    int pushed = 0;
+    while (pushed < pushes || queue.size > 0) {
+        if (pushed < pushes && (0 == queue.size || rand() % 3 != 0)) {
+            record = (ExternalRecord){.key = rand() % 1000, .sequence = pushed};
+            result = cs_extqueue_push(&queue, &record);
+            assert(result.ok, "cs_extqueue_push returned error");
+            counts[record.key] += 1;
+            pushed += 1;
+            continue;
+        }
+
+        PointerResult least = cs_extqueue_peek(&queue);
+        assert(least.ok, "cs_extqueue_peek returned error");
+        int key = ((ExternalRecord *)least.value)->key;
+        size_t size = queue.size;
+        result = cs_extqueue_pop(&queue, &record);
+        assert(result.ok && key == record.key && size - 1 == queue.size,
+            "cs_extqueue_pop did not return the peeked record");
+        assert(0 == popped[record.sequence], "line %d: record %d popped twice",
+            __LINE__, record.sequence);
+        popped[record.sequence] = 1;
+        int least_key = 0;
+        while (0 == counts[least_key]) {
+            least_key += 1;
+        }
+        assert(least_key == record.key, "line %d: popped %d, expected %d",
+            __LINE__, record.key, least_key);
+        counts[record.key] -= 1;
+    }
+    for (int i = 0; i < pushes; ++i) {
+        assert(popped[i], "line %d: record %d never popped", __LINE__, i);
+    }
+
+    // Once all of the records are pushed, pops come out fully sorted
+    for (int i = 0; i < pushes; ++i) {
+        record = (ExternalRecord){.key = (i * 7919) % pushes, .sequence = i};
+        cs_extqueue_push(&queue, &record);
+    }
+    for (int i = 0; i < pushes; ++i) {
+        result = cs_extqueue_pop(&queue, &record);
+        assert(result.ok && i == record.key, "line %d: popped %d, expected %d",
+            __LINE__, record.key, i);
+    }
+    assert(0 == queue.run_count, "runs were not closed once exhausted");
+
+    // A run that can't be written leaves the queue unchanged
+    queue.directory = "/nonexistent";
+    for (int i = 0; i < 16; ++i) {
+        record = (ExternalRecord){.key = i, .sequence = i};
+        cs_extqueue_push(&queue, &record);
+    }
+    result = cs_extqueue_push(&queue, &record);
+    assert(!result.ok && 16 == queue.size,
+        "cs_extqueue_push did not fail when spilling failed");
+    queue.directory = NULL;
+    result = cs_extqueue_push(&queue, &record);
+    assert(result.ok && 17 == queue.size && 1 == queue.run_count,
+        "cs_extqueue_push did not recover from a failed spill");
+    for (int i = 0; i < 16; ++i) {
+        result = cs_extqueue_pop(&queue, &record);
+        assert(result.ok && i == record.key, "line %d: popped %d, expected %d",
+            __LINE__, record.key, i);
+    }
+
+    free(popped);
+    cs_extqueue_free(&queue);
+}
+
+typedef struct ReactorTest {
+    Reactor reactor;
+    ReactorWatch watches[2];
+    int fds[2];
+    int calls[2];
+    char echoed[16];
+    int order[4];
+    int fired;
+    ReactorTask tasks[2];
+    int tasks_run;
+} ReactorTest;
+
+// Echo whatever arrives on the socket back to the sender
+void reactor_echo(int fd, uint32_t events, void *context) {
+    (void)context;
+    char buffer[16];
+    if (events & EPOLLIN) {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length > 0) {
+            ssize_t written = write(fd, buffer, length);
+            (void)written;
+        }
+    }
+}
+
+void reactor_receive(int fd, uint32_t events, void *context) {
+    ReactorTest *test = context;
+    if (events & EPOLLIN) {
+        ssize_t length = read(fd, test->echoed, sizeof(test->echoed) - 1);
+        test->echoed[length > 0 ? length : 0] = '\0';
+    }
+}
+
+// Each pipe's callback removes the other pipe's watch, so only the first to
+// be dispatched may run, even though both are in the same batch.
+void reactor_remove_other(int fd, uint32_t events, void *context) {
+    (void)events;
+    ReactorTest *test = context;
+    int self = fd == test->fds[0] ? 0 : 1;
+    test->calls[self] += 1;
+    cs_reactor_remove(&test->reactor, &test->watches[1 - self]);
+}
+
+typedef struct ReactorTimerTest {
+    ReactorTest *test;
+    int id;
+} ReactorTimerTest;
+
+void reactor_timer_fired(void *context) {
+    ReactorTimerTest *timer = context;
+    timer->test->order[timer->test->fired++] = timer->id;
+}
+
+void reactor_count_task(void *context) {
+    ReactorTest *test = context;
+    test->tasks_run += 1;
+}
+
+// Defers a second task, which must not run until the next iteration
+void reactor_defer_task(void *context) {
+    ReactorTest *test = context;
+    test->tasks_run += 1;
+    cs_reactor_defer(&test->reactor, &test->tasks[1], reactor_count_task, test);
+}
+
+void reactor_stop_task(void *context) {
+    ReactorTest *test = context;
+    test->tasks_run += 1;
+    cs_reactor_stop(&test->reactor);
+}
+
+void *reactor_poster(void *argument) {
+    ReactorTest *test = argument;
+    cs_reactor_post(&test->reactor, &test->tasks[0], reactor_stop_task, test);
+    return NULL;
+}
+
+void test_reactor() {
+    ReactorTest *test = calloc(1, sizeof(ReactorTest));
+    Reactor *reactor = &test->reactor;
+    VoidResult result = cs_reactor_init(reactor, 0);
+    assert(result.ok, "cs_reactor_init returned error");
+
+    // Round trip over a socketpair: one end echoes, the other receives
+    int sockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sockets);
+    cs_reactor_add(reactor, &test->watches[0], sockets[0], EPOLLIN,
+        reactor_echo, test);
+    cs_reactor_add(reactor, &test->watches[1], sockets[1], EPOLLIN,
+        reactor_receive, test);
+    ssize_t written = write(sockets[1], "hello", 5);
+    assert(5 == written, "write to socketpair failed");
+    for (int i = 0; i < 10 && '\0' == test->echoed[0]; ++i) {
+        result = cs_reactor_run_once(reactor, 100);
+        assert(result.ok, "cs_reactor_run_once returned error");
+    }
+    assert(0 == strcmp("hello", test->echoed), "line %d: echoed '%s'",
+        __LINE__, test->echoed);
+    cs_reactor_remove(reactor, &test->watches[0]);
+    cs_reactor_remove(reactor, &test->watches[1]);
+    close(sockets[0]);
+    close(sockets[1]);
+
+    // Removing a watch drops its events from the batch being dispatched
+    int pipes[2][2];
+    for (int i = 0; i < 2; ++i) {
+        int error = pipe(pipes[i]);
+        assert(0 == error, "pipe failed");
+        test->fds[i] = pipes[i][0];
+        cs_reactor_add(reactor, &test->watches[i], pipes[i][0], EPOLLIN,
+            reactor_remove_other, test);
+        written = write(pipes[i][1], "x", 1);
+    }
+    cs_reactor_run_once(reactor, 100);
+    assert(1 == test->calls[0] + test->calls[1],
+        "line %d: removed watch was dispatched", __LINE__);
+    int remaining = 0 == test->calls[0] ? 0 : 1;
+    cs_reactor_remove(reactor, &test->watches[remaining]);
+    for (int i = 0; i < 2; ++i) {
+        close(pipes[i][0]);
+        close(pipes[i][1]);
+    }
+
+    // Timers fire in order of expiry, and cancelled timers don't fire
+    ReactorTimer timers[4];
+    ReactorTimerTest contexts[4];
+    const uint64_t delays[4] = {30, 10, 20, 5};
+    for (int i = 0; i < 4; ++i) {
+        contexts[i] = (ReactorTimerTest){.test = test, .id = i};
+        cs_reactor_timer_init(&timers[i], reactor_timer_fired, &contexts[i]);
+        result = cs_reactor_timer_start(reactor, &timers[i], delays[i]);
+        assert(result.ok, "cs_reactor_timer_start returned error");
+    }
+    result = cs_reactor_timer_cancel(reactor, &timers[3]);
+    assert(result.ok, "cs_reactor_timer_cancel returned error");
+    result = cs_reactor_timer_cancel(reactor, &timers[3]);
+    assert(!result.ok && SEASTAR_ERROR_NOT_SCHEDULED == result.error,
+        "cancelling an idle timer did not return error");
+    uint64_t start = cs_reactor_now(reactor);
+    while (test->fired < 3) {
+        cs_reactor_run_once(reactor, -1);
+    }
+    assert(1 == test->order[0] && 2 == test->order[1] && 0 == test->order[2],
+        "line %d: timers fired out of order", __LINE__);
+    assert(cs_reactor_now(reactor) - start >= 30,
+        "line %d: timer fired early", __LINE__);
+
+    // Deferred tasks run at the end of the iteration, and tasks they defer
+    // wait for the next one
+    cs_reactor_defer(reactor, &test->tasks[0], reactor_defer_task, test);
+    cs_reactor_run_once(reactor, 0);
+    assert(1 == test->tasks_run, "line %d: ran %d tasks", __LINE__,
+        test->tasks_run);
+    cs_reactor_run_once(reactor, -1);
+    assert(2 == test->tasks_run, "line %d: ran %d tasks", __LINE__,
+        test->tasks_run);
+
+    // A task posted from another thread wakes the loop, and stops it
+    pthread_t poster;
+    pthread_create(&poster, NULL, reactor_poster, test);
+    result = cs_reactor_run(reactor);
+    assert(result.ok && 3 == test->tasks_run,
+        "line %d: cs_reactor_run did not run the posted task", __LINE__);
+    pthread_join(poster, NULL);
+
+    cs_reactor_free(reactor);
+    free(test);
+}
+
 int main() {
     test_vector();
     test_pqueue();
+    test_merge();
+    test_wheel();
+    test_bitset();
+    test_pool();
+    test_sorted();
+    test_btree();
+    test_wsdeque();
+    test_parallel();
+    test_snapshot();
+    test_extqueue();
+    test_reactor();
     return 0;
 }
 